@@ -0,0 +1,327 @@
+"""This file benchmarks encoding and decoding float-heavy JSON documents. All
+data is generated deterministically, no network access is required.
+
+The following workloads are available:
+
+- ``coordinates``: GeoJSON-like lists of longitude/latitude pairs, with values
+  that were rounded to a few decimal places before being stored (as is common
+  for geographic data)
+- ``canada``: polygons of full precision coordinates written with 17
+  significant digits, in the style of the ``canada.json`` benchmark file
+- ``metrics``: records of measurements (latencies, ratios, temperatures, ...)
+  with a mix of short and long representations
+- ``random``: uniformly random 64 bit floats, which need the full 17
+  significant digits to roundtrip
+
+For each workload the following encoders are measured:
+
+- ``msgspec``: the default shortest roundtrip representation
+- ``msgspec (precision=N)``: ``msgspec.json.Encoder(float_precision=N)``
+- ``json``: the standard library
+
+and the following decoders:
+
+- ``msgspec``: untyped decoding
+- ``msgspec (typed)``: decoding into a matching schema. The flat ``random``
+  array is decoded into a ``msgspec.Vector[float]``, which parses floats
+  without boxing them.
+- ``json``: the standard library
+
+Decoding also reports how many floats needed the slow high-precision fallback
+(``ms_hpd`` in ``atof.h``), used when the faster exact paths can't determine
+the correctly rounded result. Counting these requires building msgspec with
+``MSGSPEC_STATS=1``, they show as ``-`` otherwise.
+
+Floats are formatted with the Schubfach algorithm by default. To compare
+against Ryu, rebuild msgspec with ``MSGSPEC_DTOA=ryu`` and rerun.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import random
+import sys
+import timeit
+
+import msgspec
+
+
+def make_coordinates(rng, n):
+    lon, lat = rng.uniform(-180, 180), rng.uniform(-80, 80)
+    out = []
+    for _ in range(n):
+        lon += rng.uniform(-0.01, 0.01)
+        lat += rng.uniform(-0.01, 0.01)
+        out.append([round(lon, 6), round(lat, 6)])
+    return {"type": "LineString", "coordinates": out}
+
+
+def make_metrics(rng, n):
+    return [
+        {
+            "latency_ms": rng.lognormvariate(2, 1),
+            "ratio": rng.random(),
+            "temperature": round(rng.gauss(20, 5), 1),
+            "count": float(rng.randint(0, 1000)),
+        }
+        for _ in range(n)
+    ]
+
+
+def make_canada(rng, n):
+    polygons = []
+    while n > 0:
+        size = min(n, rng.randint(50, 500))
+        lon, lat = rng.uniform(-140, -50), rng.uniform(42, 83)
+        ring = []
+        for _ in range(size):
+            lon += rng.uniform(-0.01, 0.01)
+            lat += rng.uniform(-0.01, 0.01)
+            ring.append([lon, lat])
+        polygons.append([ring])
+        n -= size
+    return {"type": "MultiPolygon", "coordinates": polygons}
+
+
+def make_random(rng, n):
+    return [rng.uniform(-1e6, 1e6) * 10.0 ** rng.randint(-20, 20) for _ in range(n)]
+
+
+class LineString(msgspec.Struct):
+    type: str
+    coordinates: list[tuple[float, float]]
+
+
+class MultiPolygon(msgspec.Struct):
+    type: str
+    coordinates: list[list[list[tuple[float, float]]]]
+
+
+class Metric(msgspec.Struct):
+    latency_ms: float
+    ratio: float
+    temperature: float
+    count: float
+
+
+# name -> (generate data, typed decoding schema)
+WORKLOADS = {
+    "coordinates": (make_coordinates, LineString),
+    "canada": (make_canada, MultiPolygon),
+    "metrics": (make_metrics, list[Metric]),
+    "random": (make_random, msgspec.Vector[float]),
+}
+
+
+def dumps_17g(obj):
+    """Like ``json.dumps``, but writing floats with 17 significant digits"""
+    if isinstance(obj, float):
+        return "%.17g" % obj
+    if isinstance(obj, dict):
+        parts = (f"{json.dumps(k)}:{dumps_17g(v)}" for k, v in obj.items())
+        return "{" + ",".join(parts) + "}"
+    if isinstance(obj, list):
+        return "[" + ",".join(dumps_17g(v) for v in obj) + "]"
+    return json.dumps(obj)
+
+
+def count_floats(obj):
+    if isinstance(obj, float):
+        return 1
+    if isinstance(obj, dict):
+        return sum(count_floats(v) for v in obj.values())
+    if isinstance(obj, list):
+        return sum(count_floats(v) for v in obj)
+    return 0
+
+
+def bench(func, repeat):
+    timer = timeit.Timer(func)
+    n, _ = timer.autorange()
+    return min(timer.repeat(repeat=repeat, number=n)) / n
+
+
+def float_fallbacks(decoder):
+    try:
+        return decoder.stats()["float_fallbacks"]
+    except RuntimeError:
+        # Built without MSGSPEC_STATS
+        return None
+
+
+def bench_encode(data, n_floats, precision, repeat):
+    encoders = {
+        "msgspec": msgspec.json.Encoder().encode,
+        f"msgspec (precision={precision})": msgspec.json.Encoder(
+            float_precision=precision
+        ).encode,
+        "json": lambda obj: json.dumps(obj, separators=(",", ":")).encode(),
+    }
+    results = []
+    for label, encode in encoders.items():
+        duration = bench(lambda: encode(data), repeat)
+        results.append(
+            {
+                "op": "encode",
+                "library": label,
+                "size": len(encode(data)),
+                "ns_per_float": duration / n_floats * 1e9,
+                "fallbacks": None,
+            }
+        )
+    return results
+
+
+def bench_decode(msg, typ, n_floats, repeat):
+    decoders = {
+        "msgspec": msgspec.json.Decoder(),
+        "msgspec (typed)": msgspec.json.Decoder(typ),
+    }
+    results = []
+    for label, dec in decoders.items():
+        dec.decode(msg)
+        fallbacks = float_fallbacks(dec)
+        duration = bench(lambda: dec.decode(msg), repeat)
+        results.append(
+            {
+                "op": "decode",
+                "library": label,
+                "size": len(msg),
+                "ns_per_float": duration / n_floats * 1e9,
+                "fallbacks": fallbacks,
+            }
+        )
+    duration = bench(lambda: json.loads(msg), repeat)
+    results.append(
+        {
+            "op": "decode",
+            "library": "json",
+            "size": len(msg),
+            "ns_per_float": duration / n_floats * 1e9,
+            "fallbacks": None,
+        }
+    )
+    return results
+
+
+def bench_workload(name, size, precision, repeat):
+    make, typ = WORKLOADS[name]
+    data = make(random.Random(42), size)
+    n_floats = count_floats(data)
+    if name == "canada":
+        msg = dumps_17g(data).encode()
+    else:
+        msg = msgspec.json.encode(data)
+
+    results = bench_encode(data, n_floats, precision, repeat)
+    results.extend(bench_decode(msg, typ, n_floats, repeat))
+    for r in results:
+        r["workload"] = name
+        r["floats"] = n_floats
+    return results
+
+
+def format_table(results):
+    header = [
+        "workload",
+        "op",
+        "library",
+        "size (bytes)",
+        "ns/float",
+        "relative",
+        "fallbacks",
+    ]
+    rows = []
+    for r in results:
+        base = next(
+            x["ns_per_float"]
+            for x in results
+            if x["workload"] == r["workload"]
+            and x["op"] == r["op"]
+            and x["library"] == "msgspec"
+        )
+        if r["fallbacks"] is None:
+            fallbacks = "-"
+        else:
+            fallbacks = f"{r['fallbacks']} / {r['floats']}"
+        rows.append(
+            [
+                r["workload"],
+                r["op"],
+                r["library"],
+                str(r["size"]),
+                f"{r['ns_per_float']:.1f}",
+                f"{r['ns_per_float'] / base:.2f}",
+                fallbacks,
+            ]
+        )
+    widths = [max(len(h), *(len(row[i]) for row in rows)) for i, h in enumerate(header)]
+    lines = ["  ".join(h.ljust(w) for h, w in zip(header, widths))]
+    lines.append("  ".join("-" * w for w in widths))
+    for row in rows:
+        lines.append("  ".join(c.ljust(w) for c, w in zip(row, widths)))
+    return "\n".join(line.rstrip() for line in lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark encoding and decoding float-heavy JSON documents"
+    )
+    parser.add_argument(
+        "-w",
+        "--workload",
+        dest="workloads",
+        nargs="*",
+        choices=list(WORKLOADS),
+        default=list(WORKLOADS),
+        help="A list of workloads to run. Defaults to all.",
+    )
+    parser.add_argument(
+        "-n",
+        "--size",
+        type=int,
+        default=10_000,
+        help="The number of items in each document. Defaults to 10000.",
+    )
+    parser.add_argument(
+        "-p",
+        "--precision",
+        type=int,
+        default=6,
+        help="The ``float_precision`` to benchmark. Defaults to 6.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=5,
+        help="The number of timing repeats, the best is reported. Defaults to 5.",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        help="A path to write the results to as JSON, or '-' for stdout",
+    )
+    args = parser.parse_args()
+
+    results = []
+    for name in args.workloads:
+        results.extend(bench_workload(name, args.size, args.precision, args.repeat))
+
+    if args.output is not None:
+        report = {
+            "python": sys.version,
+            "msgspec": msgspec.__version__,
+            "results": results,
+        }
+        if args.output == "-":
+            json.dump(report, sys.stdout, indent=2)
+            return
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    print(format_table(results))
+
+
+if __name__ == "__main__":
+    main()
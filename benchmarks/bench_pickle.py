@@ -0,0 +1,137 @@
+"""This file benchmarks pickling a ``list[Struct]`` with protocol 5.
+
+The following containers are compared:
+
+- ``list``: a plain list, each struct is pickled individually
+- ``StructList``: ``msgspec.structs.StructList``, the whole list is pickled as
+  a single MessagePack message wrapped in a ``PickleBuffer``
+
+Each is measured both in-band, and out-of-band with a ``buffer_callback``.
+"""
+
+from __future__ import annotations
+
+import argparse
+import pickle
+import timeit
+
+import msgspec
+from msgspec.structs import StructList
+
+
+class Point(msgspec.Struct):
+    x: float
+    y: float
+
+
+class Record(msgspec.Struct):
+    id: int
+    name: str
+    email: str
+    tags: list[str]
+    score: float
+    active: bool
+
+
+def make_points(n):
+    return [Point(i * 0.5, -i * 0.25) for i in range(n)]
+
+
+def make_records(n):
+    return [
+        Record(
+            i,
+            f"user {i}",
+            f"user{i}@example.com",
+            ["a", "b", "c"][: i % 4],
+            i / 7,
+            i % 2 == 0,
+        )
+        for i in range(n)
+    ]
+
+
+WORKLOADS = {"points": make_points, "records": make_records}
+
+
+def bench(func, repeat):
+    timer = timeit.Timer(func)
+    n, _ = timer.autorange()
+    return min(timer.repeat(repeat=repeat, number=n)) / n
+
+
+def bench_one(obj, out_of_band, repeat):
+    def dumps():
+        buffers = []
+        data = pickle.dumps(
+            obj,
+            protocol=5,
+            buffer_callback=buffers.append if out_of_band else None,
+        )
+        return data, buffers
+
+    data, buffers = dumps()
+    size = len(data) + sum(len(b.raw()) for b in buffers)
+    assert pickle.loads(data, buffers=buffers) == obj
+
+    dump_time = bench(dumps, repeat)
+    load_time = bench(lambda: pickle.loads(data, buffers=buffers), repeat)
+    return size, dump_time, load_time
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark pickling lists of structs with protocol 5"
+    )
+    parser.add_argument(
+        "-w",
+        "--workload",
+        dest="workloads",
+        nargs="*",
+        choices=list(WORKLOADS),
+        default=list(WORKLOADS),
+        help="A list of workloads to run. Defaults to all.",
+    )
+    parser.add_argument(
+        "-n",
+        "--size",
+        type=int,
+        default=100_000,
+        help="The number of structs in each list. Defaults to 100000.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=5,
+        help="The number of timing repeats, the best is reported. Defaults to 5.",
+    )
+    args = parser.parse_args()
+
+    header = ["workload", "container", "buffers", "size (bytes)", "dumps", "loads"]
+    rows = []
+    for name in args.workloads:
+        items = WORKLOADS[name](args.size)
+        for container in [list, StructList]:
+            obj = container(items)
+            for out_of_band in [False, True]:
+                size, dump_time, load_time = bench_one(obj, out_of_band, args.repeat)
+                rows.append(
+                    [
+                        name,
+                        container.__name__,
+                        "out-of-band" if out_of_band else "in-band",
+                        str(size),
+                        f"{dump_time * 1e3:.2f} ms",
+                        f"{load_time * 1e3:.2f} ms",
+                    ]
+                )
+
+    widths = [max(len(h), *(len(row[i]) for row in rows)) for i, h in enumerate(header)]
+    print("  ".join(h.ljust(w) for h, w in zip(header, widths)).rstrip())
+    print("  ".join("-" * w for w in widths))
+    for row in rows:
+        print("  ".join(c.ljust(w) for c, w in zip(row, widths)).rstrip())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,471 @@
+"""This file benchmarks encoding and decoding synthetic documents of various
+shapes and sizes. All data is generated deterministically, no network access is
+required.
+
+The following workloads are available:
+
+- ``strings``: records of mostly string values, including escapes and non-ascii
+- ``numbers``: rows of integers and floats
+- ``nested``: deeply nested objects
+- ``wide``: Structs with many fields
+- ``union``: a tagged union of Struct types
+- ``ndjson``: many small records, each encoded as a separate message
+
+For each workload, size, and protocol (JSON and MessagePack) the following is
+measured for encoding, typed decoding, and untyped decoding:
+
+- Throughput in MB/s
+- Peak memory traced by ``tracemalloc``
+- The number of memory blocks allocated to hold the output (as counted by
+  ``tracemalloc``)
+
+as well as the peak RSS of the process running the benchmark. Every
+workload/size/protocol combination runs in its own subprocess to isolate their
+memory usage.
+
+Results are printed as a table, and may also be written as JSON for regression
+tracking with ``--output``.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import random
+import resource
+import subprocess
+import sys
+import timeit
+import tracemalloc
+import zlib
+from typing import Literal, Optional, Union
+
+import msgspec
+
+WORDS = [
+    "alpha",
+    "bravo",
+    "charlie",
+    "delta",
+    "echo",
+    "foxtrot",
+    "golf",
+    "hotel",
+    "india",
+    "juliett",
+    "café",
+    "naïve",
+    "日本語",
+    "emoji 🚀",
+    'with "quotes"',
+    "tab\tand\nnewline",
+    "back\\slash",
+]
+
+
+def make_text(rng, n_words):
+    return " ".join(rng.choice(WORDS) for _ in range(n_words))
+
+
+# strings
+
+
+def make_strings(rng):
+    return {f"key_{i}": make_text(rng, rng.randint(1, 12)) for i in range(8)}
+
+
+STRINGS_TYPE = dict[str, str]
+
+
+# numbers
+
+
+def make_numbers(rng):
+    return [
+        rng.randint(-(2**63), 2**63 - 1),
+        rng.randint(0, 1000),
+        rng.uniform(-1e6, 1e6),
+        round(rng.random(), 3),
+        rng.random() * 10 ** rng.randint(-20, 20),
+    ]
+
+
+NUMBERS_TYPE = tuple[int, int, float, float, float]
+
+
+# nested
+
+
+class Node(msgspec.Struct):
+    level: int
+    name: str
+    tags: list[str]
+    attrs: dict[str, float]
+    child: Optional[Node] = None
+
+
+def make_nested(rng, depth=32):
+    node = None
+    for level in reversed(range(depth)):
+        node = {
+            "level": level,
+            "name": rng.choice(WORDS),
+            "tags": [rng.choice(WORDS) for _ in range(rng.randint(0, 3))],
+            "attrs": {"x": rng.random(), "y": rng.random()},
+            "child": node,
+        }
+    return node
+
+
+NESTED_TYPE = Node
+
+
+# wide
+
+WIDE_FIELD_TYPES = [int, float, str, bool, Optional[str], list[int]]
+
+Wide = msgspec.defstruct(
+    "Wide",
+    [(f"field_{i}", WIDE_FIELD_TYPES[i % len(WIDE_FIELD_TYPES)]) for i in range(64)],
+    gc=False,
+)
+
+
+def make_wide(rng):
+    out = {}
+    for i in range(64):
+        typ = WIDE_FIELD_TYPES[i % len(WIDE_FIELD_TYPES)]
+        if typ is int:
+            value = rng.randint(-(2**31), 2**31)
+        elif typ is float:
+            value = rng.random()
+        elif typ is str:
+            value = rng.choice(WORDS)
+        elif typ is bool:
+            value = rng.random() < 0.5
+        elif typ == list[int]:
+            value = [rng.randint(0, 100) for _ in range(rng.randint(0, 4))]
+        else:
+            value = rng.choice([None, rng.choice(WORDS)])
+        out[f"field_{i}"] = value
+    return out
+
+
+WIDE_TYPE = Wide
+
+
+# union
+
+
+class Get(msgspec.Struct, tag="get", gc=False):
+    key: str
+
+
+class Put(msgspec.Struct, tag="put", gc=False):
+    key: str
+    value: str
+    ttl: Optional[int] = None
+
+
+class Delete(msgspec.Struct, tag="delete", gc=False):
+    keys: list[str]
+
+
+def make_union(rng):
+    kind = rng.choice(["get", "put", "delete"])
+    key = f"user:{rng.randint(0, 10**6)}"
+    if kind == "get":
+        return {"type": "get", "key": key}
+    elif kind == "put":
+        return {
+            "type": "put",
+            "key": key,
+            "value": make_text(rng, 4),
+            "ttl": rng.choice([None, rng.randint(1, 3600)]),
+        }
+    else:
+        return {"type": "delete", "keys": [key, f"user:{rng.randint(0, 10**6)}"]}
+
+
+UNION_TYPE = Union[Get, Put, Delete]
+
+
+# ndjson
+
+
+class Record(msgspec.Struct, gc=False):
+    id: int
+    timestamp: str
+    level: Literal["debug", "info", "warning", "error"]
+    message: str
+    tags: list[str]
+    latency: float
+
+
+def make_record(rng):
+    return {
+        "id": rng.randint(0, 2**40),
+        "timestamp": (
+            f"2024-{rng.randint(1, 12):02d}-{rng.randint(1, 28):02d}T"
+            f"{rng.randint(0, 23):02d}:{rng.randint(0, 59):02d}:"
+            f"{rng.randint(0, 59):02d}Z"
+        ),
+        "level": rng.choice(["debug", "info", "warning", "error"]),
+        "message": make_text(rng, rng.randint(3, 10)),
+        "tags": [rng.choice(WORDS) for _ in range(rng.randint(0, 3))],
+        "latency": round(rng.expovariate(10), 6),
+    }
+
+
+WORKLOADS = {
+    "strings": (make_strings, STRINGS_TYPE),
+    "numbers": (make_numbers, NUMBERS_TYPE),
+    "nested": (make_nested, NESTED_TYPE),
+    "wide": (make_wide, WIDE_TYPE),
+    "union": (make_union, UNION_TYPE),
+    "ndjson": (make_record, Record),
+}
+
+UNITS = {"b": 1, "kb": 1024, "mb": 1024**2, "gb": 1024**3}
+
+
+def parse_size(size):
+    s = size.strip().lower()
+    for unit in ["kb", "mb", "gb", "b"]:
+        if s.endswith(unit):
+            return int(float(s[: -len(unit)]) * UNITS[unit])
+    return int(s)
+
+
+def make_data(workload, nbytes):
+    """Generate approximately ``nbytes`` (when JSON encoded) of builtin objects
+    for a workload"""
+    make_item, _ = WORKLOADS[workload]
+    rng = random.Random(zlib.crc32(workload.encode()))
+    sample = [make_item(rng) for _ in range(32)]
+    item_size = len(msgspec.json.encode(sample)) / len(sample)
+    n = max(1, round(nbytes / item_size))
+    return sample[:n] + [make_item(rng) for _ in range(n - len(sample))]
+
+
+def make_codec(workload, proto):
+    _, typ = WORKLOADS[workload]
+    mod = getattr(msgspec, proto)
+    enc = mod.Encoder()
+    untyped = mod.Decoder()
+
+    if workload != "ndjson":
+        typed = mod.Decoder(list[typ])
+        return enc.encode, typed.decode, untyped.decode, list[typ]
+
+    typed = mod.Decoder(typ)
+
+    # NDJSON workloads encode each record as a separate message. For JSON these
+    # are written out as newline-delimited JSON, for MessagePack as a list of
+    # messages.
+    if proto == "json":
+        return enc.encode_lines, typed.decode_lines, untyped.decode_lines, list[typ]
+
+    def encode(items):
+        return [enc.encode(x) for x in items]
+
+    def decode_typed(msgs):
+        return [typed.decode(m) for m in msgs]
+
+    def decode_untyped(msgs):
+        return [untyped.decode(m) for m in msgs]
+
+    return encode, decode_typed, decode_untyped, list[typ]
+
+
+def nbytes_of(msg):
+    if isinstance(msg, list):
+        return sum(len(m) for m in msg)
+    return len(msg)
+
+
+def bench_op(func, arg, nbytes, repeat):
+    timer = timeit.Timer("func(arg)", globals={"func": func, "arg": arg})
+    n, _ = timer.autorange()
+    t = min(timer.repeat(repeat=repeat, number=n)) / n
+
+    tracemalloc.start()
+    out = func(arg)
+    _, peak = tracemalloc.get_traced_memory()
+    blocks = sum(s.count for s in tracemalloc.take_snapshot().statistics("filename"))
+    tracemalloc.stop()
+    del out
+
+    return {
+        "mb_per_s": nbytes / t / 1e6,
+        "time_ms": t * 1000,
+        "peak_traced_mib": peak / (1024 * 1024),
+        "blocks": blocks,
+    }
+
+
+def max_rss_mib():
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # ru_maxrss is in bytes on macOS, and KiB elsewhere
+    return rss / (1024 * 1024) if sys.platform == "darwin" else rss / 1024
+
+
+def run_worker(workload, size, proto, repeat):
+    encode, decode, decode_untyped, typ = make_codec(workload, proto)
+    data = msgspec.convert(make_data(workload, parse_size(size)), typ)
+    msg = encode(data)
+    nbytes = nbytes_of(msg)
+    setup_rss = max_rss_mib()
+
+    ops = {
+        "encode": bench_op(encode, data, nbytes, repeat),
+        "decode": bench_op(decode, msg, nbytes, repeat),
+        "decode (untyped)": bench_op(decode_untyped, msg, nbytes, repeat),
+    }
+    peak_rss = max_rss_mib()
+    return [
+        {
+            "workload": workload,
+            "size": size,
+            "protocol": proto,
+            "op": op,
+            "nbytes": nbytes,
+            "peak_rss_mib": peak_rss,
+            "rss_increase_mib": peak_rss - setup_rss,
+            **res,
+        }
+        for op, res in ops.items()
+    ]
+
+
+def format_table(results):
+    columns = (
+        "workload",
+        "size",
+        "proto",
+        "op",
+        "MB/s",
+        "traced peak (MiB)",
+        "blocks",
+        "peak RSS (MiB)",
+    )
+    rows = [
+        (
+            r["workload"],
+            r["size"],
+            r["protocol"],
+            r["op"],
+            f"{r['mb_per_s']:.1f}",
+            f"{r['peak_traced_mib']:.2f}",
+            f"{r['blocks']}",
+            f"{r['peak_rss_mib']:.1f}",
+        )
+        for r in results
+    ]
+    widths = tuple(max(max(map(len, x)), len(c)) for x, c in zip(zip(*rows), columns))
+    row_template = ("|" + (" %%-%ds |" * len(columns))) % widths
+    header = row_template % tuple(columns)
+    bar_underline = "+%s+" % "+".join("=" * (w + 2) for w in widths)
+    bar = "+%s+" % "+".join("-" * (w + 2) for w in widths)
+    parts = [bar, header, bar_underline]
+    for r in rows:
+        parts.append(row_template % r)
+        parts.append(bar)
+    return "\n".join(parts)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark encoding and decoding synthetic documents"
+    )
+    parser.add_argument(
+        "-w",
+        "--workload",
+        dest="workloads",
+        nargs="*",
+        choices=list(WORKLOADS),
+        default=list(WORKLOADS),
+        help="A list of workloads to run. Defaults to all.",
+    )
+    parser.add_argument(
+        "-s",
+        "--size",
+        dest="sizes",
+        nargs="*",
+        default=["1KB", "1MB", "32MB"],
+        help=(
+            "A list of approximate document sizes (e.g. 1KB, 64MB, 1GB). "
+            "Defaults to 1KB 1MB 32MB."
+        ),
+    )
+    parser.add_argument(
+        "-p",
+        "--protocol",
+        dest="protocols",
+        nargs="*",
+        choices=["json", "msgpack"],
+        default=["json", "msgpack"],
+        help="A list of protocols to benchmark. Defaults to both.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=3,
+        help="The number of timing repeats, the best is reported. Defaults to 3.",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        help="A path to write the results to as JSON, or '-' for stdout",
+    )
+    parser.add_argument("--worker", nargs=3, help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.worker:
+        workload, size, proto = args.worker
+        print(json.dumps(run_worker(workload, size, proto, args.repeat)))
+        return
+
+    for size in args.sizes:
+        parse_size(size)
+
+    results = []
+    for workload in args.workloads:
+        for size in args.sizes:
+            for proto in args.protocols:
+                # We execute each benchmark in a subprocess to isolate their
+                # memory usage
+                output = subprocess.check_output(
+                    [
+                        sys.executable,
+                        __file__,
+                        "--worker",
+                        workload,
+                        size,
+                        proto,
+                        "--repeat",
+                        str(args.repeat),
+                    ]
+                )
+                results.extend(json.loads(output))
+                if args.output != "-":
+                    print(f"Finished {workload} {size} {proto}", file=sys.stderr)
+
+    if args.output is not None:
+        report = {
+            "python": sys.version,
+            "platform": sys.platform,
+            "msgspec": msgspec.__version__,
+            "results": results,
+        }
+        if args.output == "-":
+            json.dump(report, sys.stdout, indent=2)
+            return
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    print(format_table(results))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,339 @@
+"""This file benchmarks how encoding and decoding throughput scales with the
+number of threads. It is mostly useful on free-threaded builds of Python, on
+builds with the GIL enabled throughput shouldn't increase with more threads.
+
+Each scenario runs N threads calling the same operation in a loop, and reports
+throughput and scaling efficiency (throughput with N threads divided by N times
+the single threaded throughput).
+
+Most scenarios come in pairs, differing only in whether an object is shared
+between threads. Comparing the efficiency of a scenario with its baseline
+isolates the cost of contention on that object:
+
+- ``decode shared decoder``: all threads share one ``Decoder``
+- ``decode shared type``: each thread has its own ``Decoder``, but all decode
+  the same ``Struct`` type (contention on type object refcounts)
+- ``decode isolated``: each thread has its own ``Decoder`` and ``Struct`` type
+- ``encode shared dict``: all threads encode the same dict (contention on the
+  per-dict critical section taken while encoding)
+- ``encode isolated``: each thread encodes its own copy of the data
+- ``build decoder shared type``: threads repeatedly create a ``Decoder`` for
+  the same ``Struct`` type (contention on the per-type critical section taken
+  while converting the type)
+- ``build decoder isolated``: threads repeatedly create a ``Decoder`` for their
+  own ``Struct`` type (contention on the module-wide struct lookup cache)
+
+Scenarios with an efficiency below ``--threshold`` relative to their baseline
+(or absolute, for scenarios without one) are flagged along with the shared
+resource that likely limits their scaling. Nothing is flagged when the GIL is
+enabled.
+"""
+
+from __future__ import annotations
+
+import argparse
+import copy
+import json
+import os
+import sys
+import threading
+import time
+import timeit
+
+import msgspec
+
+
+def make_point_type(name="Point"):
+    return msgspec.defstruct(
+        name, [("x", int), ("y", int), ("label", str), ("tags", list[str])]
+    )
+
+
+Point = make_point_type()
+
+POINTS = [
+    {"x": i, "y": -i, "label": f"point-{i}", "tags": ["a", "b"]} for i in range(100)
+]
+
+DOCUMENT = {
+    "version": 1,
+    "items": [{"id": i, "name": f"item-{i}", "value": i * 1.5} for i in range(100)],
+    "meta": {f"key-{i}": f"value-{i}" for i in range(20)},
+}
+
+POINTS_MSG = msgspec.json.encode(POINTS)
+
+
+def decode_shared_decoder(n_threads):
+    dec = msgspec.json.Decoder(list[Point])
+    return [lambda: dec.decode(POINTS_MSG)] * n_threads
+
+
+def decode_shared_type(n_threads):
+    funcs = []
+    for _ in range(n_threads):
+        dec = msgspec.json.Decoder(list[Point])
+        funcs.append(lambda dec=dec: dec.decode(POINTS_MSG))
+    return funcs
+
+
+def decode_isolated(n_threads):
+    funcs = []
+    for i in range(n_threads):
+        dec = msgspec.json.Decoder(list[make_point_type(f"Point{i}")])
+        msg = bytes(POINTS_MSG)
+        funcs.append(lambda dec=dec, msg=msg: dec.decode(msg))
+    return funcs
+
+
+def encode_shared_dict(n_threads):
+    funcs = []
+    for _ in range(n_threads):
+        enc = msgspec.json.Encoder()
+        funcs.append(lambda enc=enc: enc.encode(DOCUMENT))
+    return funcs
+
+
+def encode_isolated(n_threads):
+    funcs = []
+    for _ in range(n_threads):
+        enc = msgspec.json.Encoder()
+        doc = copy.deepcopy(DOCUMENT)
+        funcs.append(lambda enc=enc, doc=doc: enc.encode(doc))
+    return funcs
+
+
+def build_decoder_shared_type(n_threads):
+    return [lambda: msgspec.json.Decoder(list[Point])] * n_threads
+
+
+def build_decoder_isolated(n_threads):
+    funcs = []
+    for i in range(n_threads):
+        typ = list[make_point_type(f"Point{i}")]
+        funcs.append(lambda typ=typ: msgspec.json.Decoder(typ))
+    return funcs
+
+
+# name -> (setup, baseline, suspected source of contention)
+SCENARIOS = {
+    "decode shared decoder": (
+        decode_shared_decoder,
+        "decode shared type",
+        "shared Decoder instance",
+    ),
+    "decode shared type": (
+        decode_shared_type,
+        "decode isolated",
+        "refcounts on shared Struct type objects",
+    ),
+    "decode isolated": (decode_isolated, None, "contention outside msgspec"),
+    "encode shared dict": (
+        encode_shared_dict,
+        "encode isolated",
+        "per-dict critical section in json_encode_dict",
+    ),
+    "encode isolated": (encode_isolated, None, "contention outside msgspec"),
+    "build decoder shared type": (
+        build_decoder_shared_type,
+        "build decoder isolated",
+        "per-type critical section in StructInfo_Convert",
+    ),
+    "build decoder isolated": (
+        build_decoder_isolated,
+        None,
+        "struct_lookup_cache critical section in typenode_collect_convert_structs",
+    ),
+}
+
+
+def calibrate(setup):
+    """Find a number of iterations taking ~0.2 s on a single thread"""
+    (func,) = setup(1)
+    n, _ = timeit.Timer(func).autorange()
+    return n
+
+
+def run_threads(funcs, number):
+    barrier = threading.Barrier(len(funcs) + 1)
+
+    def worker(func):
+        barrier.wait()
+        for _ in range(number):
+            func()
+
+    threads = [threading.Thread(target=worker, args=(f,)) for f in funcs]
+    for t in threads:
+        t.start()
+    barrier.wait()
+    start = time.perf_counter()
+    for t in threads:
+        t.join()
+    return time.perf_counter() - start
+
+
+def bench_scenario(setup, thread_counts, repeat):
+    number = calibrate(setup)
+    results = {}
+    for n_threads in thread_counts:
+        funcs = setup(n_threads)
+        duration = min(run_threads(funcs, number) for _ in range(repeat))
+        results[n_threads] = n_threads * number / duration
+    return results
+
+
+def default_thread_counts():
+    max_threads = os.cpu_count() or 1
+    counts = [1]
+    while counts[-1] * 2 <= max_threads:
+        counts.append(counts[-1] * 2)
+    if counts[-1] != max_threads:
+        counts.append(max_threads)
+    return counts
+
+
+def gil_enabled():
+    return getattr(sys, "_is_gil_enabled", lambda: True)()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark multi-threaded encoding and decoding throughput"
+    )
+    parser.add_argument(
+        "-s",
+        "--scenario",
+        dest="scenarios",
+        nargs="*",
+        choices=list(SCENARIOS),
+        default=list(SCENARIOS),
+        help="A list of scenarios to run. Defaults to all.",
+    )
+    parser.add_argument(
+        "-t",
+        "--threads",
+        type=int,
+        nargs="*",
+        help="A list of thread counts. Defaults to powers of 2 up to the CPU count.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=3,
+        help="The number of timing repeats, the best is reported. Defaults to 3.",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.8,
+        help=(
+            "Flag scenarios with a scaling efficiency (relative to their "
+            "baseline) below this value. Defaults to 0.8."
+        ),
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        help="A path to write the results to as JSON, or '-' for stdout",
+    )
+    args = parser.parse_args()
+
+    thread_counts = sorted(set([1] + (args.threads or default_thread_counts())))
+
+    if gil_enabled():
+        print(
+            "Warning: the GIL is enabled, throughput is not expected to scale "
+            "with the number of threads",
+            file=sys.stderr,
+        )
+
+    # Baselines are needed to compute relative efficiency
+    names = list(args.scenarios)
+    for name in args.scenarios:
+        baseline = SCENARIOS[name][1]
+        if baseline is not None and baseline not in names:
+            names.append(baseline)
+
+    throughput = {}
+    for name in names:
+        throughput[name] = bench_scenario(
+            SCENARIOS[name][0], thread_counts, args.repeat
+        )
+
+    max_threads = thread_counts[-1]
+    results = []
+    for name in names:
+        _, baseline, suspect = SCENARIOS[name]
+        tput = throughput[name]
+        efficiency = {n: tput[n] / (n * tput[1]) for n in thread_counts}
+        if baseline is not None:
+            base_tput = throughput[baseline]
+            relative = efficiency[max_threads] / (
+                base_tput[max_threads] / (max_threads * base_tput[1])
+            )
+        else:
+            relative = efficiency[max_threads]
+        results.append(
+            {
+                "scenario": name,
+                "baseline": baseline,
+                "throughput": {str(n): t for n, t in tput.items()},
+                "efficiency": {str(n): e for n, e in efficiency.items()},
+                "relative_efficiency": relative,
+                "flagged": (
+                    not gil_enabled() and max_threads > 1 and relative < args.threshold
+                ),
+                "suspect": suspect,
+            }
+        )
+
+    if args.output is not None:
+        report = {
+            "python": sys.version,
+            "gil_enabled": gil_enabled(),
+            "cpu_count": os.cpu_count(),
+            "msgspec": msgspec.__version__,
+            "results": results,
+        }
+        if args.output == "-":
+            json.dump(report, sys.stdout, indent=2)
+            return
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    columns = (
+        "",
+        "ops/s (1 thread)",
+        *(f"eff. ({n})" for n in thread_counts[1:]),
+        "vs. baseline",
+    )
+    rows = [
+        (
+            f"**{r['scenario']}**",
+            f"{r['throughput']['1']:.0f}",
+            *(f"{r['efficiency'][str(n)]:.2f}" for n in thread_counts[1:]),
+            f"{r['relative_efficiency']:.2f}" if r["baseline"] else "",
+        )
+        for r in results
+    ]
+    widths = tuple(max(max(map(len, x)), len(c)) for x, c in zip(zip(*rows), columns))
+    row_template = ("|" + (" %%-%ds |" * len(columns))) % widths
+    header = row_template % tuple(columns)
+    bar_underline = "+%s+" % "+".join("=" * (w + 2) for w in widths)
+    bar = "+%s+" % "+".join("-" * (w + 2) for w in widths)
+    parts = [bar, header, bar_underline]
+    for r in rows:
+        parts.append(row_template % r)
+        parts.append(bar)
+    print("\n".join(parts))
+
+    flagged = [r for r in results if r["flagged"]]
+    for r in flagged:
+        print(
+            f"- {r['scenario']}: efficiency {r['relative_efficiency']:.2f} "
+            f"with {max_threads} threads, likely limited by {r['suspect']}"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,175 @@
+"""This file benchmarks decoding a large TOML document made up of many
+service definitions, in the style of a deployment configuration file.
+
+The native decoder is compared against ``tomllib.loads``, both on its own and
+followed by ``msgspec.convert`` (how ``msgspec.toml.decode`` was implemented
+before it had a native parser).
+
+For each method, the following is measured:
+
+- Time to decode the document
+- Peak memory used while decoding the document
+"""
+
+import argparse
+import datetime
+import timeit
+import tracemalloc
+from typing import Dict, List, Optional
+
+try:
+    import tomllib
+except ImportError:
+    import tomli as tomllib
+
+import msgspec
+
+
+def service(i):
+    return f"""\
+[[services]]
+name = "service-{i}"
+image = "registry.example.com/service-{i}:1.{i}.0"
+replicas = {i % 5 + 1}
+enabled = {"true" if i % 3 else "false"}
+args = ["--port", "8080", "--verbose"]
+created = 2024-01-{i % 28 + 1:02d}T12:30:00Z
+weight = {i / 7:.4f}
+
+[services.env]
+LOG_LEVEL = "info"
+REGION = 'us-east-{i % 4}'
+
+[services.resources]
+limits = {{ cpu = "500m", memory = "128Mi" }}
+requests = {{ cpu = "250m", memory = "64Mi" }}
+
+[[services.ports]]
+container_port = 8080
+protocol = "TCP"
+
+[[services.ports]]
+container_port = {9000 + i}
+protocol = "UDP"
+
+"""
+
+
+def make_document(n):
+    parts = [
+        'title = "deployment"\n',
+        "version = 3\n",
+        "\n",
+        "[owner]\n",
+        'name = "platform team"\n',
+        "updated = 2024-02-03T04:05:06.789-07:00\n",
+        "\n",
+    ]
+    parts.extend(service(i) for i in range(n))
+    return "".join(parts)
+
+
+class Owner(msgspec.Struct):
+    name: str
+    updated: datetime.datetime
+
+
+class Port(msgspec.Struct):
+    container_port: int
+    protocol: str = "TCP"
+
+
+class Service(msgspec.Struct):
+    name: str
+    image: str
+    replicas: int
+    enabled: bool
+    args: List[str]
+    created: datetime.datetime
+    weight: float
+    env: Dict[str, str] = {}
+    resources: Dict[str, Dict[str, str]] = {}
+    ports: List[Port] = []
+
+
+class Deployment(msgspec.Struct):
+    title: str
+    version: int
+    owner: Owner
+    services: List[Service]
+    description: Optional[str] = None
+
+
+BENCHMARKS = [
+    ("tomllib", tomllib.loads),
+    (
+        "tomllib + convert",
+        lambda data: msgspec.convert(tomllib.loads(data), type=Deployment),
+    ),
+    ("msgspec", msgspec.toml.decode),
+    (
+        "msgspec structs",
+        lambda data: msgspec.toml.decode(data, type=Deployment),
+    ),
+]
+
+
+def bench(decode, data):
+    timer = timeit.Timer("decode(data)", globals={"decode": decode, "data": data})
+    n, _ = timer.autorange()
+    time_ms = min(timer.repeat(repeat=3, number=n)) / n * 1000
+
+    tracemalloc.start()
+    decode(data)
+    _, peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return peak / (1024 * 1024), time_ms
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark decoding a large TOML document"
+    )
+    parser.add_argument(
+        "-n",
+        "--num-services",
+        type=int,
+        default=500,
+        help="The number of services in the document. Defaults to 500.",
+    )
+    args = parser.parse_args()
+
+    data = make_document(args.num_services)
+    print(f"Decoding a {len(data.encode()) / 1000:.0f} kB document")
+
+    results = {}
+    for name, decode in BENCHMARKS:
+        results[name] = bench(decode, data)
+
+    best_mem, best_time = results["msgspec structs"]
+    columns = ("", "memory (MiB)", "vs.", "time (ms)", "vs.")
+    rows = [
+        (
+            f"**{name}**",
+            f"{mem:.1f}",
+            f"{mem / best_mem:.1f}x",
+            f"{time:.1f}",
+            f"{time / best_time:.1f}x",
+        )
+        for name, (mem, time) in results.items()
+    ]
+    rows.sort(key=lambda x: float(x[3]))
+    widths = tuple(max(max(map(len, x)), len(c)) for x, c in zip(zip(*rows), columns))
+    row_template = ("|" + (" %%-%ds |" * len(columns))) % widths
+    header = row_template % tuple(columns)
+    bar_underline = "+%s+" % "+".join("=" * (w + 2) for w in widths)
+    bar = "+%s+" % "+".join("-" * (w + 2) for w in widths)
+    parts = [bar, header, bar_underline]
+    for r in rows:
+        parts.append(row_template % r)
+        parts.append(bar)
+    print("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main()
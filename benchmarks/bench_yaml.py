@@ -0,0 +1,206 @@
+"""This file benchmarks decoding a large YAML document made up of many
+Kubernetes-style manifests.
+
+For each method, the following is measured:
+
+- Time to decode the document
+- Peak memory used while decoding the document
+"""
+
+import argparse
+import textwrap
+import timeit
+import tracemalloc
+from typing import Dict, List, Optional
+
+import yaml
+
+import msgspec
+
+
+def manifest(i):
+    return f"""\
+apiVersion: apps/v1
+kind: Deployment
+metadata:
+  name: service-{i}
+  namespace: default
+  labels:
+    app: service-{i}
+    tier: backend
+  annotations:
+    deployment.kubernetes.io/revision: "{i}"
+spec:
+  replicas: 3
+  selector:
+    matchLabels:
+      app: service-{i}
+  template:
+    metadata:
+      labels:
+        app: service-{i}
+    spec:
+      containers:
+        - name: app
+          image: registry.example.com/service-{i}:1.{i}.0
+          args: ["--port", "8080", "--verbose"]
+          ports:
+            - containerPort: 8080
+              protocol: TCP
+          env:
+            - name: LOG_LEVEL
+              value: info
+            - name: ENABLED
+              value: "true"
+          resources:
+            limits: {{cpu: 500m, memory: 128Mi}}
+            requests: {{cpu: 250m, memory: 64Mi}}
+          readinessProbe:
+            httpGet:
+              path: /healthz
+              port: 8080
+            initialDelaySeconds: 5
+            periodSeconds: 10
+      nodeSelector:
+        kubernetes.io/os: linux
+"""
+
+
+def make_document(n):
+    parts = ["apiVersion: v1\nkind: List\nitems:\n"]
+    for i in range(n):
+        body = textwrap.indent(manifest(i), "    ")
+        parts.append("  - " + body[4:])
+    return "".join(parts).encode()
+
+
+class Metadata(msgspec.Struct):
+    name: Optional[str] = None
+    labels: Dict[str, str] = {}
+    namespace: Optional[str] = None
+    annotations: Dict[str, str] = {}
+
+
+class Port(msgspec.Struct, rename="camel"):
+    container_port: int
+    protocol: str = "TCP"
+
+
+class EnvVar(msgspec.Struct):
+    name: str
+    value: str
+
+
+class Container(msgspec.Struct):
+    name: str
+    image: str
+    args: List[str] = []
+    ports: List[Port] = []
+    env: List[EnvVar] = []
+    resources: Dict[str, Dict[str, str]] = {}
+
+
+class PodSpec(msgspec.Struct, rename="camel"):
+    containers: List[Container]
+    node_selector: Dict[str, str] = {}
+
+
+class PodTemplate(msgspec.Struct):
+    metadata: Metadata
+    spec: PodSpec
+
+
+class DeploymentSpec(msgspec.Struct):
+    replicas: int
+    template: PodTemplate
+
+
+class Deployment(msgspec.Struct, rename="camel"):
+    api_version: str
+    kind: str
+    metadata: Metadata
+    spec: DeploymentSpec
+
+
+class DeploymentList(msgspec.Struct, rename="camel"):
+    api_version: str
+    kind: str
+    items: List[Deployment]
+
+
+def pyyaml_loader(loader):
+    return lambda data: yaml.load(data, Loader=loader)
+
+
+BENCHMARKS = [
+    ("pyyaml", pyyaml_loader(yaml.SafeLoader)),
+    ("pyyaml (libyaml)", pyyaml_loader(getattr(yaml, "CSafeLoader", None))),
+    ("msgspec", msgspec.yaml.decode),
+    (
+        "msgspec structs",
+        lambda data: msgspec.yaml.decode(data, type=DeploymentList),
+    ),
+]
+
+
+def bench(decode, data):
+    timer = timeit.Timer("decode(data)", globals={"decode": decode, "data": data})
+    n, _ = timer.autorange()
+    time_ms = min(timer.repeat(repeat=3, number=n)) / n * 1000
+
+    tracemalloc.start()
+    decode(data)
+    _, peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return peak / (1024 * 1024), time_ms
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark decoding a large YAML document"
+    )
+    parser.add_argument(
+        "-n",
+        "--num-manifests",
+        type=int,
+        default=500,
+        help="The number of manifests in the document. Defaults to 500.",
+    )
+    args = parser.parse_args()
+
+    data = make_document(args.num_manifests)
+    print(f"Decoding a {len(data) / 1000:.0f} kB document")
+
+    results = {}
+    for name, decode in BENCHMARKS:
+        if "libyaml" in name and not hasattr(yaml, "CSafeLoader"):
+            continue
+        results[name] = bench(decode, data)
+
+    best_mem, best_time = results["msgspec structs"]
+    columns = ("", "memory (MiB)", "vs.", "time (ms)", "vs.")
+    rows = [
+        (
+            f"**{name}**",
+            f"{mem:.1f}",
+            f"{mem / best_mem:.1f}x",
+            f"{time:.1f}",
+            f"{time / best_time:.1f}x",
+        )
+        for name, (mem, time) in results.items()
+    ]
+    rows.sort(key=lambda x: float(x[3]))
+    widths = tuple(max(max(map(len, x)), len(c)) for x, c in zip(zip(*rows), columns))
+    row_template = ("|" + (" %%-%ds |" * len(columns))) % widths
+    header = row_template % tuple(columns)
+    bar_underline = "+%s+" % "+".join("=" * (w + 2) for w in widths)
+    bar = "+%s+" % "+".join("-" * (w + 2) for w in widths)
+    parts = [bar, header, bar_underline]
+    for r in rows:
+        parts.append(row_template % r)
+        parts.append(bar)
+    print("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,48 @@
+"""The training workload used for profile-guided optimized builds (see
+``MSGSPEC_PGO`` in ``setup.py``).
+
+This exercises the common encode/decode paths for both JSON and MessagePack,
+reusing the workloads from ``bench_synthetic`` and ``bench_validation`` (the
+latter is also what ``tests/prof`` profiles). It should take a few seconds to
+run with an instrumented build.
+"""
+
+import msgspec
+
+from .bench_synthetic import WORKLOADS, make_codec, make_data
+from .bench_validation import bench_msgspec
+from .generate_data import make_filesystem_data
+
+
+def train_synthetic(nbytes=1024 * 1024, repeat=5):
+    for workload in WORKLOADS:
+        raw = make_data(workload, nbytes)
+        for proto in ["json", "msgpack"]:
+            encode, decode, decode_untyped, typ = make_codec(workload, proto)
+            data = msgspec.convert(raw, typ)
+            msg = encode(data)
+            for _ in range(repeat):
+                encode(data)
+                decode(msg)
+                decode_untyped(msg)
+        msgspec.to_builtins(data)
+
+
+def train_validation(size=1000, repeat=20):
+    data = msgspec.convert(make_filesystem_data(size), bench_msgspec.Directory)
+    for proto in [msgspec.json, msgspec.msgpack]:
+        enc = proto.Encoder()
+        dec = proto.Decoder(bench_msgspec.Directory)
+        msg = enc.encode(data)
+        for _ in range(repeat):
+            enc.encode(data)
+            dec.decode(msg)
+
+
+def main():
+    train_synthetic()
+    train_validation()
+
+
+if __name__ == "__main__":
+    main()
@@ -58,7 +58,12 @@ def gen_row(e):
     return "{0x%s, 0x%s},  // 1e%-04d" % (h[16:], h[:16], e)
 
 
-table_rows = [gen_row(e) for e in range(-307, 289)]
+# The smallest power of 10 that can still produce a non-zero double from a
+# 19 digit mantissa, and the largest that can produce a finite one
+POW10_MIN = -342
+POW10_MAX = 308
+
+table_rows = [gen_row(e) for e in range(POW10_MIN, POW10_MAX + 1)]
 
 f64_powers = [f"1e{i}" for i in range(23)]
 
@@ -70,6 +75,9 @@ text = """\
 #ifndef MSGSPEC_ATOF_CONSTS_H
 #define MSGSPEC_ATOF_CONSTS_H
 
+#define MS_ATOF_POW10_MIN (%d)
+#define MS_ATOF_POW10_MAX %d
+
 static const uint64_t ms_atof_powers_of_10[%d][2] = {
 %s
 };
@@ -88,6 +96,8 @@ static const uint8_t ms_atof_powers_of_5[%d] = {
 
 #endif
 """ % (
+    POW10_MIN,
+    POW10_MAX,
     len(table_rows),
     "\n".join(table_rows),
     len(f64_powers),
@@ -101,6 +111,6 @@ static const uint8_t ms_atof_powers_of_5[%d] = {
 
 if __name__ == "__main__":
     repo = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
-    path = os.path.join(repo, "msgspec", "atof_consts.h")
+    path = os.path.join(repo, "src", "msgspec", "atof_consts.h")
     with open(path, "wb") as f:
         f.write(text.encode("utf-8"))
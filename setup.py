@@ -1,8 +1,13 @@
 import os
 import platform
+import shutil
+import subprocess
 import sys
+import sysconfig
+import tempfile
 
 from setuptools import setup
+from setuptools.command.build_ext import build_ext
 from setuptools.extension import Extension
 
 # Check for 32-bit windows builds, which currently aren't supported. We can't
@@ -26,15 +31,25 @@ if sys.platform == "win32" and sys.maxsize == (2**31 - 1):
 SANITIZE = os.environ.get("MSGSPEC_SANITIZE", False)
 COVERAGE = os.environ.get("MSGSPEC_COVERAGE", False)
 DEBUG = os.environ.get("MSGSPEC_DEBUG", SANITIZE or COVERAGE)
+STATS = os.environ.get("MSGSPEC_STATS", False)
+DTOA = os.environ.get("MSGSPEC_DTOA", "schubfach")
+PGO = os.environ.get("MSGSPEC_PGO", False) and not DEBUG
 
 extra_compile_args = []
 extra_link_args = []
+define_macros = []
 if SANITIZE:
     extra_compile_args.extend(["-fsanitize=address", "-fsanitize=undefined"])
     extra_link_args.extend(["-lasan", "-lubsan"])
 if COVERAGE:
     extra_compile_args.append("--coverage")
     extra_link_args.append("-lgcov")
+if STATS:
+    define_macros.append(("MS_STATS", "1"))
+if DTOA == "ryu":
+    define_macros.append(("MS_DTOA_RYU", "1"))
+elif DTOA != "schubfach":
+    raise ValueError(f"MSGSPEC_DTOA must be 'schubfach' or 'ryu', got {DTOA!r}")
 if DEBUG:
     extra_compile_args.extend(["-O0", "-g", "-UNDEBUG"])
 elif sys.platform != "win32":
@@ -52,15 +67,103 @@ if sys.platform == "win32":
         ]
     )
 
+
+class pgo_build_ext(build_ext):
+    """A `build_ext` that optionally does a profile-guided optimized build.
+
+    With `MSGSPEC_PGO` set, the extension is first built with instrumentation,
+    then the training workload in `benchmarks/pgo_training.py` is run against
+    it, and finally the extension is rebuilt using the collected profile and
+    LTO. This requires a source checkout and GCC or Clang."""
+
+    def build_extensions(self):
+        if not PGO:
+            return super().build_extensions()
+
+        if self.compiler.compiler_type != "unix":
+            raise RuntimeError("MSGSPEC_PGO requires GCC or Clang")
+        if not os.path.exists(os.path.join("benchmarks", "pgo_training.py")):
+            raise RuntimeError("MSGSPEC_PGO requires a source checkout of msgspec")
+
+        clang = self._is_clang()
+        profile_dir = os.path.abspath(os.path.join(self.build_temp, "pgo-profile"))
+        shutil.rmtree(profile_dir, ignore_errors=True)
+        self.force = True
+
+        orig = [(e, e.extra_compile_args, e.extra_link_args) for e in self.extensions]
+
+        # Build with instrumentation
+        flag = f"-fprofile-generate={profile_dir}"
+        for ext, compile_args, link_args in orig:
+            ext.extra_compile_args = compile_args + [flag]
+            ext.extra_link_args = link_args + [flag]
+        super().build_extensions()
+
+        # Collect a profile
+        self._run_training()
+        if clang:
+            profile = os.path.join(profile_dir, "msgspec.profdata")
+            raws = [
+                os.path.join(profile_dir, f)
+                for f in os.listdir(profile_dir)
+                if f.endswith(".profraw")
+            ]
+            subprocess.check_call(
+                ["llvm-profdata", "merge", f"--output={profile}", *raws]
+            )
+            use = [f"-fprofile-use={profile}", "-Wno-profile-instr-unprofiled"]
+            lto = ["-flto=thin"]
+        else:
+            use = [f"-fprofile-use={profile_dir}", "-Wno-missing-profile"]
+            lto = ["-flto=auto"]
+
+        # Rebuild using the profile, with LTO
+        for ext, compile_args, link_args in orig:
+            ext.extra_compile_args = compile_args + use + lto
+            ext.extra_link_args = link_args + use + lto
+        super().build_extensions()
+
+    def _is_clang(self):
+        try:
+            out = subprocess.check_output(
+                [self.compiler.compiler[0], "--version"], text=True
+            )
+        except (OSError, subprocess.CalledProcessError):
+            return False
+        return "clang" in out
+
+    def _run_training(self):
+        with tempfile.TemporaryDirectory() as tmpdir:
+            # Assemble an importable package from the sources and the
+            # instrumented extension
+            pkg = os.path.join(tmpdir, "msgspec")
+            shutil.copytree(os.path.join("src", "msgspec"), pkg)
+            for name in os.listdir(pkg):
+                if name.startswith("_core.") and not name.endswith(".c"):
+                    os.remove(os.path.join(pkg, name))
+            ext_path = self.get_ext_fullpath("msgspec._core")
+            shutil.copy(
+                ext_path,
+                os.path.join(pkg, "_core" + sysconfig.get_config_var("EXT_SUFFIX")),
+            )
+            env = dict(os.environ)
+            env["PYTHONPATH"] = os.pathsep.join([tmpdir, os.path.abspath(".")])
+            subprocess.check_call(
+                [sys.executable, "-m", "benchmarks.pgo_training"], env=env
+            )
+
+
 ext_modules = [
     Extension(
         "msgspec._core",
         [os.path.join("src", "msgspec", "_core.c")],
         extra_compile_args=extra_compile_args,
         extra_link_args=extra_link_args,
+        define_macros=define_macros,
     )
 ]
 
 setup(
     ext_modules=ext_modules,
+    cmdclass={"build_ext": pgo_build_ext},
 )
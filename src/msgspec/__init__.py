@@ -1,6 +1,7 @@
 from ._core import (
     NODEFAULT,
     UNSET,
+    ArrowBatch,
     DecodeError,
     EncodeError,
     Field as _Field,
@@ -11,6 +12,7 @@ from ._core import (
     StructMeta,
     UnsetType,
     ValidationError,
+    Vector,
     convert,
     defstruct,
     to_builtins,
@@ -24,5 +26,5 @@ def field(*, default=NODEFAULT, default_factory=NODEFAULT, name=None):
 field.__doc__ = _Field.__doc__
 
 
-from . import inspect, json, msgpack, structs, toml, yaml
+from . import cbor, inspect, json, msgpack, structs, toml, yaml
 from ._version import __version__
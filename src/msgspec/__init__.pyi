@@ -1,4 +1,5 @@
 import enum
+from array import array as _array
 from inspect import Signature
 from typing import (
     Any,
@@ -19,7 +20,7 @@ from typing import (
 
 from typing_extensions import Buffer, dataclass_transform
 
-from . import inspect, json, msgpack, structs, toml, yaml
+from . import cbor, inspect, json, msgpack, structs, toml, yaml
 
 # PEP 673 explicitly rejects using Self in metaclass definitions:
 # https://peps.python.org/pep-0673/#valid-locations-for-self
@@ -64,6 +65,7 @@ class StructMeta(type):
         weakref: bool = False,
         dict: bool = False,
         cache_hash: bool = False,
+        unboxed: bool = False,
     ) -> _SM: ...
 
 T = TypeVar("T")
@@ -114,6 +116,7 @@ class Struct(metaclass=StructMeta):
         weakref: bool = False,
         dict: bool = False,
         cache_hash: bool = False,
+        unboxed: bool = False,
     ) -> None: ...
     def __rich_repr__(
         self,
@@ -146,6 +149,7 @@ def defstruct(
     weakref: bool = False,
     dict: bool = False,
     cache_hash: bool = False,
+    unboxed: bool = False,
 ) -> Type[Struct]: ...
 
 # Lie and say `Raw` is a subclass of `bytes`, so mypy will accept it in most
@@ -157,6 +161,19 @@ class Raw(bytes):
     def __new__(cls, msg: Union[Buffer, str]) -> "Raw": ...
     def copy(self) -> "Raw": ...
 
+# `Vector[T]` decodes into an `array.array`, have type checkers treat it as one
+Vector = _array
+
+class ArrowBatch:
+    def __len__(self) -> int: ...
+    def __arrow_c_schema__(self) -> object: ...
+    def __arrow_c_array__(
+        self, requested_schema: Optional[object] = None
+    ) -> Tuple[object, object]: ...
+    def __arrow_c_stream__(
+        self, requested_schema: Optional[object] = None
+    ) -> object: ...
+
 class Meta:
     def __init__(
         self,
@@ -1,5 +1,7 @@
 # type: ignore
 import collections
+import contextlib
+import mmap
 import sys
 import typing
 from typing import _AnnotatedAlias  # noqa: F401
@@ -310,3 +312,25 @@ def _wrap_attrs_validators(fields, post_init):
 def rebuild(cls, kwargs):
     """Used to unpickle Structs with keyword-only fields"""
     return cls(**kwargs)
+
+
+@contextlib.contextmanager
+def mmap_file(path):
+    """Memory map a file for reading, hinting the OS that it will be read
+    sequentially. Empty files (which can't be mapped) yield ``b""``."""
+    with open(path, "rb") as f:
+        if f.seek(0, 2) == 0:
+            yield b""
+            return
+        buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    try:
+        if hasattr(mmap, "MADV_SEQUENTIAL"):
+            buf.madvise(mmap.MADV_SEQUENTIAL)
+        yield buf
+    finally:
+        try:
+            buf.close()
+        except BufferError:
+            # Zero-copy values (`Raw`, `memoryview`) in the decoded output
+            # still reference the map, it's closed once they're released.
+            pass
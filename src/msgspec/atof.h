@@ -109,6 +109,25 @@ ms_clzll(uint64_t x) {
 #endif
 }
 
+/* Count trailing zero bits, `x` must be non-zero */
+static inline uint32_t
+ms_ctzll(uint64_t x) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64) || defined(_M_IA64))
+  unsigned long index = 0;
+  _BitScanForward64(&index, x);
+  return (uint32_t)index;
+#elif defined(__GNUC__)
+  return (uint32_t)__builtin_ctzll(x);
+#else
+    uint32_t out = 0;
+    while ((x & 1) == 0) {
+        out++;
+        x >>= 1;
+    }
+    return out;
+#endif
+}
+
 static inline int64_t
 eisel_lemire(uint64_t man, int32_t exp) {
     /* The short comment headers below correspond to section titles in Nigel
@@ -117,7 +136,7 @@ eisel_lemire(uint64_t man, int32_t exp) {
      * in-depth description of the algorithm */
 
     /* Normalization */
-    const uint64_t* po10 = ms_atof_powers_of_10[exp + 307];
+    const uint64_t* po10 = ms_atof_powers_of_10[exp - MS_ATOF_POW10_MIN];
     uint32_t clz = ms_clzll(man);
     man <<= clz;
     uint64_t ret_exp2 = ((uint64_t)(((217706 * exp) >> 16) + 1087)) - ((uint64_t)clz);
@@ -166,11 +185,88 @@ eisel_lemire(uint64_t man, int32_t exp) {
 		ret_exp2++;
 	}
 
+    /* Range check, subnormal and infinite results are left to the fallback */
+    if ((ret_exp2 - 1) >= 0x7FF - 1) {
+        return -1;
+    }
+
     /* Construct final output */
 	ret_mantissa &= 0x000FFFFFFFFFFFFF;
     return ((int64_t)(ret_mantissa | (ret_exp2 << 52)));
 }
 
+/* Exact conversion of `man * 10^exp` for small exponents, resolving most
+ * cases where `eisel_lemire` aborts (typically floats that are exactly
+ * representable, like `4873108843191699.0`) without needing the much slower
+ * HPD fallback. The scaled mantissa is computed exactly with 128 bit
+ * arithmetic (tracking whether a division had a remainder), then rounded
+ * half-to-even to 53 bits. Returns -1 if the inputs are out of range. */
+static inline int64_t
+ms_atof_exact_small_exponent(uint64_t man, int64_t exp) {
+#if defined(__SIZEOF_INT128__)
+    static const uint64_t pow10[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+        10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+        100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL, 1000000000000000000ULL,
+        10000000000000000000ULL
+    };
+    static const uint64_t pow5[28] = {
+        1ULL, 5ULL, 25ULL, 125ULL, 625ULL, 3125ULL, 15625ULL, 78125ULL,
+        390625ULL, 1953125ULL, 9765625ULL, 48828125ULL, 244140625ULL,
+        1220703125ULL, 6103515625ULL, 30517578125ULL, 152587890625ULL,
+        762939453125ULL, 3814697265625ULL, 19073486328125ULL,
+        95367431640625ULL, 476837158203125ULL, 2384185791015625ULL,
+        11920928955078125ULL, 59604644775390625ULL, 298023223876953125ULL,
+        1490116119384765625ULL, 7450580596923828125ULL
+    };
+    __uint128_t q;
+    bool sticky = false;
+    int64_t exp2;
+
+    if (exp >= 0) {
+        if (exp > 19) return -1;
+        q = ((__uint128_t)man) * pow10[exp];
+        exp2 = 0;
+    }
+    else {
+        /* man / 10^k == (man * 2^64 / 5^k) * 2^(-64 - k) */
+        if (exp < -27) return -1;
+        uint64_t d = pow5[-exp];
+        __uint128_t n = ((__uint128_t)man) << 64;
+        q = n / d;
+        sticky = (n - q * d) != 0;
+        exp2 = exp - 64;
+    }
+
+    uint64_t hi = (uint64_t)(q >> 64);
+    uint64_t lo = (uint64_t)q;
+    uint32_t nbits = hi ? 128 - ms_clzll(hi) : (lo ? 64 - ms_clzll(lo) : 0);
+    /* At least one bit past the mantissa is needed to round */
+    if (nbits < 54) return -1;
+
+    uint32_t shift = nbits - 53;
+    uint64_t ret_mantissa = (uint64_t)(q >> shift);
+    __uint128_t rest = q & ((((__uint128_t)1) << shift) - 1);
+    __uint128_t half = ((__uint128_t)1) << (shift - 1);
+    if (rest > half || (rest == half && (sticky || (ret_mantissa & 1)))) {
+        ret_mantissa++;
+        if ((ret_mantissa >> 53) > 0) {
+            ret_mantissa >>= 1;
+            shift++;
+        }
+    }
+
+    int64_t ret_exp2 = exp2 + shift + 1075;
+    if (ret_exp2 <= 0 || ret_exp2 >= 2047) return -1;
+    ret_mantissa &= 0x000FFFFFFFFFFFFF;
+    return ((int64_t)(ret_mantissa | (((uint64_t)ret_exp2) << 52)));
+#else
+    return -1;
+#endif
+}
+
 /* Fallback parsing method using a High Precision Double (HPD) */
 #define MS_HPD_MAX_DIGITS 800
 #define MS_HPD_DP_RANGE 2047
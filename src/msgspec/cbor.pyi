@@ -0,0 +1,136 @@
+from os import PathLike
+from typing import (
+    Any,
+    Callable,
+    Generic,
+    Literal,
+    Optional,
+    Type,
+    TypeVar,
+    Union,
+    overload,
+)
+
+from typing_extensions import Buffer
+
+T = TypeVar("T")
+
+enc_hook_sig = Optional[Callable[[Any], Any]]
+tag_hook_sig = Optional[Callable[[int, Any], Any]]
+dec_hook_sig = Optional[Callable[[type, Any], Any]]
+
+class Decoder(Generic[T]):
+    type: Type[T]
+    strict: bool
+    dec_hook: dec_hook_sig
+    tag_hook: tag_hook_sig
+    @overload
+    def __init__(
+        self: Decoder[Any],
+        *,
+        strict: bool = True,
+        dec_hook: dec_hook_sig = None,
+        tag_hook: tag_hook_sig = None,
+    ) -> None: ...
+    @overload
+    def __init__(
+        self: Decoder[T],
+        type: Type[T] = ...,
+        *,
+        strict: bool = True,
+        dec_hook: dec_hook_sig = None,
+        tag_hook: tag_hook_sig = None,
+    ) -> None: ...
+    @overload
+    def __init__(
+        self: Decoder[Any],
+        type: Any = ...,
+        *,
+        strict: bool = True,
+        dec_hook: dec_hook_sig = None,
+        tag_hook: tag_hook_sig = None,
+    ) -> None: ...
+    def decode(self, buf: Buffer, /) -> T: ...
+    def stats(self) -> dict[str, Any]: ...
+
+class Encoder:
+    enc_hook: enc_hook_sig
+    decimal_format: Literal["string", "number"]
+    uuid_format: Literal["canonical", "hex", "bytes"]
+    order: Literal[None, "deterministic", "sorted"]
+    def __init__(
+        self,
+        *,
+        enc_hook: enc_hook_sig = None,
+        decimal_format: Literal["string", "number"] = "string",
+        uuid_format: Literal["canonical", "hex", "bytes"] = "canonical",
+        order: Literal[None, "deterministic", "sorted"] = None,
+    ): ...
+    def encode(self, obj: Any, /) -> bytes: ...
+    def encode_into(
+        self, obj: Any, buffer: bytearray, offset: Optional[int] = 0, /
+    ) -> None: ...
+    def stats(self) -> dict[str, Any]: ...
+
+@overload
+def decode(
+    buf: Buffer,
+    /,
+    *,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    tag_hook: tag_hook_sig = None,
+) -> Any: ...
+@overload
+def decode(
+    buf: Buffer,
+    /,
+    *,
+    type: Type[T] = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    tag_hook: tag_hook_sig = None,
+) -> T: ...
+@overload
+def decode(
+    buf: Buffer,
+    /,
+    *,
+    type: Any = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    tag_hook: tag_hook_sig = None,
+) -> Any: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    tag_hook: tag_hook_sig = None,
+) -> Any: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Type[T] = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    tag_hook: tag_hook_sig = None,
+) -> T: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Any = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    tag_hook: tag_hook_sig = None,
+) -> Any: ...
+def encode(
+    obj: Any,
+    /,
+    *,
+    enc_hook: enc_hook_sig = None,
+    order: Literal[None, "deterministic", "sorted"] = None,
+) -> bytes: ...
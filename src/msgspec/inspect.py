@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import array
 import datetime
 import decimal
 import enum
@@ -72,6 +73,7 @@ __all__ = (
     "SetType",
     "FrozenSetType",
     "VarTupleType",
+    "VectorType",
     "TupleType",
     "DictType",
     "Field",
@@ -438,6 +440,22 @@ class FrozenSetType(CollectionType):
     """
 
 
+class VectorType(CollectionType):
+    """A type corresponding to a `msgspec.Vector`.
+
+    Parameters
+    ----------
+    item_type: Type
+        The item type, either an `IntType` or a `FloatType`.
+    min_length: int, optional
+        If set, an instance of this type must have length greater than or equal
+        to ``min_length``.
+    max_length: int, optional
+        If set, an instance of this type must have length less than or equal
+        to ``max_length``.
+    """
+
+
 class TupleType(Type):
     """A type corresponding to `tuple`.
 
@@ -844,6 +862,12 @@ class _Translator:
                 min_length=min_length,
                 max_length=max_length,
             )
+        elif t is msgspec.Vector or (t is array.array and args):
+            return VectorType(
+                self.translate(args[0]) if args else AnyType(),
+                min_length=min_length,
+                max_length=max_length,
+            )
         elif t is set:
             return SetType(
                 self.translate(args[0]) if args else AnyType(),
@@ -1,8 +1,102 @@
+from typing import Any as _Any
+
 from ._core import (
     JSONDecoder as Decoder,
     JSONEncoder as Encoder,
+    _json_line_spans,
     json_decode as decode,
     json_encode as encode,
     json_format as format,
 )
 from ._json_schema import schema, schema_components
+from ._utils import mmap_file as _mmap_file
+
+# The number of bytes scanned for lines at a time by `iter_lines_file`
+_LINES_CHUNK_SIZE = 1 << 20
+
+
+def decode_file(path, *, type=_Any, strict=True, dec_hook=None):
+    """Deserialize an object from a JSON file.
+
+    The file is memory mapped and decoded in place, rather than first being
+    read into memory.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        The path of the file to decode.
+    type : type, optional
+        A Python type (in type annotation form) to decode the object as. If
+        provided, the message will be type checked and decoded as the
+        specified type. Defaults to `Any`, in which case the message will be
+        decoded using the default JSON types.
+    strict : bool, optional
+        Whether type coercion rules should be strict. Setting to False enables
+        a wider set of coercion rules from string to non-string types for all
+        values. Default is True.
+    dec_hook : callable, optional
+        An optional callback for handling decoding custom types. Should have
+        the signature ``dec_hook(type: Type, obj: Any) -> Any``, where ``type``
+        is the expected message type, and ``obj`` is the decoded representation
+        composed of only basic JSON types. This hook should transform ``obj``
+        into type ``type``, or raise a ``NotImplementedError`` if unsupported.
+
+    Returns
+    -------
+    obj : Any
+        The deserialized object.
+
+    See Also
+    --------
+    decode
+    """
+    with _mmap_file(path) as buf:
+        return decode(buf, type=type, strict=strict, dec_hook=dec_hook)
+
+
+def iter_lines_file(path, *, type=_Any, strict=True, dec_hook=None, float_hook=None):
+    """Iterate over the objects in a newline-delimited JSON file.
+
+    The file is memory mapped and decoded lazily one line at a time, so only
+    the objects currently being processed are held in memory. Blank lines are
+    skipped. Finding the line boundaries is done without holding the GIL.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        The path of the file to decode.
+    type : type, optional
+        A Python type (in type annotation form) to decode each line as.
+        Defaults to `Any`, in which case each line will be decoded using the
+        default JSON types.
+    strict : bool, optional
+        Whether type coercion rules should be strict. See `Decoder` for more
+        information.
+    dec_hook : callable, optional
+        An optional callback for handling decoding custom types. See `Decoder`
+        for more information.
+    float_hook : callable, optional
+        An optional callback for handling decoding untyped float literals. See
+        `Decoder` for more information.
+
+    Yields
+    ------
+    obj : Any
+        The deserialized object for each line.
+
+    See Also
+    --------
+    Decoder.decode_lines
+    """
+    dec = Decoder(type, strict=strict, dec_hook=dec_hook, float_hook=float_hook)
+    with _mmap_file(path) as buf:
+        view = memoryview(buf)
+        try:
+            pos = 0
+            size = len(buf)
+            while pos < size:
+                spans, pos = _json_line_spans(buf, pos, pos + _LINES_CHUNK_SIZE)
+                for i in range(0, len(spans), 2):
+                    yield dec.decode(view[spans[i] : spans[i + 1]])
+        finally:
+            view.release()
@@ -1,10 +1,14 @@
-from collections.abc import Callable, Iterable
+from array import array
+from collections.abc import Callable, Iterable, Iterator
+from os import PathLike
 from typing import (
     Any,
     Dict,
     Generic,
     Literal,
+    Mapping,
     Optional,
+    Sequence,
     Tuple,
     Type,
     TypeVar,
@@ -14,6 +18,8 @@ from typing import (
 
 from typing_extensions import Buffer
 
+from . import ArrowBatch
+
 T = TypeVar("T")
 
 enc_hook_sig = Optional[Callable[[Any], Any]]
@@ -26,6 +32,7 @@ class Encoder:
     decimal_format: Literal["string", "number"]
     uuid_format: Literal["canonical", "hex"]
     order: Literal[None, "deterministic", "sorted"]
+    float_precision: Optional[int]
 
     def __init__(
         self,
@@ -34,12 +41,21 @@ class Encoder:
         decimal_format: Literal["string", "number"] = "string",
         uuid_format: Literal["canonical", "hex"] = "canonical",
         order: Literal[None, "deterministic", "sorted"] = None,
+        float_precision: Optional[int] = None,
     ): ...
     def encode(self, obj: Any, /) -> bytes: ...
     def encode_lines(self, items: Iterable, /) -> bytes: ...
     def encode_into(
         self, obj: Any, buffer: bytearray, offset: Optional[int] = 0, /
     ) -> None: ...
+    def encode_columns(
+        self,
+        columns: Mapping[str, Union[Sequence[Any], Buffer]],
+        /,
+        *,
+        layout: Literal["records", "lines"] = "records",
+    ) -> bytes: ...
+    def stats(self) -> dict[str, Any]: ...
 
 class Decoder(Generic[T]):
     type: Type[T]
@@ -75,6 +91,11 @@ class Decoder(Generic[T]):
     ) -> None: ...
     def decode(self, buf: Union[Buffer, str], /) -> T: ...
     def decode_lines(self, buf: Union[Buffer, str], /) -> list[T]: ...
+    def decode_columns(
+        self, buf: Union[Buffer, str], /
+    ) -> dict[str, Union[array[Any], list[Any]]]: ...
+    def decode_arrow(self, buf: Union[Buffer, str], /) -> ArrowBatch: ...
+    def stats(self) -> dict[str, Any]: ...
 
 @overload
 def decode(
@@ -102,6 +123,55 @@ def decode(
     strict: bool = True,
     dec_hook: dec_hook_sig = None,
 ) -> Any: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+) -> Any: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Type[T] = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+) -> T: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Any = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+) -> Any: ...
+@overload
+def iter_lines_file(
+    path: Union[str, PathLike[str]],
+    *,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    float_hook: float_hook_sig = None,
+) -> Iterator[Any]: ...
+@overload
+def iter_lines_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Type[T] = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    float_hook: float_hook_sig = None,
+) -> Iterator[T]: ...
+@overload
+def iter_lines_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Any = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    float_hook: float_hook_sig = None,
+) -> Iterator[Any]: ...
 def encode(
     obj: Any,
     /,
@@ -1,3 +1,5 @@
+from typing import Any as _Any
+
 from ._core import (
     Ext,
     MsgpackDecoder as Decoder,
@@ -5,3 +7,53 @@ from ._core import (
     msgpack_decode as decode,
     msgpack_encode as encode,
 )
+from ._utils import mmap_file as _mmap_file
+
+
+def decode_file(path, *, type=_Any, strict=True, dec_hook=None, ext_hook=None):
+    """Deserialize an object from a MessagePack file.
+
+    The file is memory mapped and decoded in place, rather than first being
+    read into memory.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        The path of the file to decode.
+    type : type, optional
+        A Python type (in type annotation form) to decode the object as. If
+        provided, the message will be type checked and decoded as the
+        specified type. Defaults to `Any`, in which case the message will be
+        decoded using the default MessagePack types.
+    strict : bool, optional
+        Whether type coercion rules should be strict. Setting to False enables
+        a wider set of coercion rules from string to non-string types for all
+        values. Default is True.
+    dec_hook : callable, optional
+        An optional callback for handling decoding custom types. Should have
+        the signature ``dec_hook(type: Type, obj: Any) -> Any``, where ``type``
+        is the expected message type, and ``obj`` is the decoded representation
+        composed of only basic MessagePack types. This hook should transform
+        ``obj`` into type ``type``, or raise a ``NotImplementedError`` if
+        unsupported.
+    ext_hook : callable, optional
+        An optional callback for decoding MessagePack extensions. Should have
+        the signature ``ext_hook(code: int, data: memoryview) -> Any``. If
+        provided, this will be called to deserialize all extension types found
+        in the message. Note that ``data`` is a memoryview into the mapped
+        file - any references to it kept without copying the data out will
+        keep the file mapped in memory.
+
+    Returns
+    -------
+    obj : Any
+        The deserialized object.
+
+    See Also
+    --------
+    decode
+    """
+    with _mmap_file(path) as buf:
+        return decode(
+            buf, type=type, strict=strict, dec_hook=dec_hook, ext_hook=ext_hook
+        )
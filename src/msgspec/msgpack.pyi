@@ -1,9 +1,13 @@
+from array import array
+from os import PathLike
 from typing import (
     Any,
     Callable,
     Generic,
     Literal,
+    Mapping,
     Optional,
+    Sequence,
     Type,
     TypeVar,
     Union,
@@ -12,6 +16,8 @@ from typing import (
 
 from typing_extensions import Buffer
 
+from . import ArrowBatch
+
 T = TypeVar("T")
 
 enc_hook_sig = Optional[Callable[[Any], Any]]
@@ -30,6 +36,7 @@ class Decoder(Generic[T]):
     strict: bool
     dec_hook: dec_hook_sig
     ext_hook: ext_hook_sig
+    typed_array_ext: Optional[int]
     @overload
     def __init__(
         self: Decoder[Any],
@@ -37,6 +44,7 @@ class Decoder(Generic[T]):
         strict: bool = True,
         dec_hook: dec_hook_sig = None,
         ext_hook: ext_hook_sig = None,
+        typed_array_ext: Optional[int] = None,
     ) -> None: ...
     @overload
     def __init__(
@@ -46,6 +54,7 @@ class Decoder(Generic[T]):
         strict: bool = True,
         dec_hook: dec_hook_sig = None,
         ext_hook: ext_hook_sig = None,
+        typed_array_ext: Optional[int] = None,
     ) -> None: ...
     @overload
     def __init__(
@@ -55,26 +64,40 @@ class Decoder(Generic[T]):
         strict: bool = True,
         dec_hook: dec_hook_sig = None,
         ext_hook: ext_hook_sig = None,
+        typed_array_ext: Optional[int] = None,
     ) -> None: ...
     def decode(self, buf: Buffer, /) -> T: ...
+    def decode_columns(
+        self, buf: Buffer, /
+    ) -> dict[str, Union[array[Any], list[Any]]]: ...
+    def decode_arrow(self, buf: Buffer, /) -> ArrowBatch: ...
+    def stats(self) -> dict[str, Any]: ...
 
 class Encoder:
     enc_hook: enc_hook_sig
     decimal_format: Literal["string", "number"]
     uuid_format: Literal["canonical", "hex", "bytes"]
+    float_format: Literal["float64", "float32", "smallest"]
     order: Literal[None, "deterministic", "sorted"]
+    typed_array_ext: Optional[int]
     def __init__(
         self,
         *,
         enc_hook: enc_hook_sig = None,
         decimal_format: Literal["string", "number"] = "string",
         uuid_format: Literal["canonical", "hex", "bytes"] = "canonical",
+        float_format: Literal["float64", "float32", "smallest"] = "float64",
         order: Literal[None, "deterministic", "sorted"] = None,
+        typed_array_ext: Optional[int] = None,
     ): ...
     def encode(self, obj: Any, /) -> bytes: ...
     def encode_into(
         self, obj: Any, buffer: bytearray, offset: Optional[int] = 0, /
     ) -> None: ...
+    def encode_columns(
+        self, columns: Mapping[str, Union[Sequence[Any], Buffer]], /
+    ) -> bytes: ...
+    def stats(self) -> dict[str, Any]: ...
 
 @overload
 def decode(
@@ -105,6 +128,32 @@ def decode(
     dec_hook: dec_hook_sig = None,
     ext_hook: ext_hook_sig = None,
 ) -> Any: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    ext_hook: ext_hook_sig = None,
+) -> Any: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Type[T] = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    ext_hook: ext_hook_sig = None,
+) -> T: ...
+@overload
+def decode_file(
+    path: Union[str, PathLike[str]],
+    *,
+    type: Any = ...,
+    strict: bool = True,
+    dec_hook: dec_hook_sig = None,
+    ext_hook: ext_hook_sig = None,
+) -> Any: ...
 def encode(
     obj: Any,
     /,
@@ -894,6 +894,15 @@ static inline floating_decimal_64 d2d(const uint64_t ieeeMantissa, const uint32_
   return fd;
 }
 
+/* The shortest digits are found using Schubfach by default, building with
+ * `MS_DTOA_RYU` defined uses Ryu's `d2d` instead */
+#ifdef MS_DTOA_RYU
+#define ms_d2d d2d
+#else
+#include "schubfach.h"
+#define ms_d2d schubfach_d2d
+#endif
+
 static inline int
 write_exponent(int32_t k, char* buf) {
     int sign = k < 0;
@@ -917,9 +926,13 @@ write_exponent(int32_t k, char* buf) {
     }
 }
 
-/* Write a double to buf, requires 24 bytes of space */
-static inline int
-write_f64(double f, char* buf, bool allow_nonfinite) {
+/* Write a double to buf, requires 24 bytes of space.
+ *
+ * If `py_repr` is true the output matches Python's `repr(float)` instead:
+ * scientific notation is used outside of `1e-4 <= abs(f) < 1e16`, and the
+ * exponent is always signed and at least two digits (`1e-07`, `1e+300`). */
+static MS_INLINE int
+write_f64_common(double f, char* buf, bool allow_nonfinite, bool py_repr) {
     const uint64_t bits = double_to_bits(f);
     const int sign = ((bits >> (DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BITS)) & 1) != 0;
     const uint64_t ieee_mantissa = bits & ((1ull << DOUBLE_MANTISSA_BITS) - 1);
@@ -954,7 +967,7 @@ write_f64(double f, char* buf, bool allow_nonfinite) {
         return sign + 3;
     }
 
-    floating_decimal_64 v = d2d(ieee_mantissa, ieee_exponent);
+    floating_decimal_64 v = ms_d2d(ieee_mantissa, ieee_exponent);
 
     int length = write_u64(v.mantissa, buf) - buf;
     int32_t k = v.exponent;
@@ -972,7 +985,7 @@ write_f64(double f, char* buf, bool allow_nonfinite) {
         *(buf + kk) = '.';
         return sign + length + 1;
     }
-    else if (-5 < kk && kk <= 0) {
+    else if ((py_repr ? -4 : -5) < kk && kk <= 0) {
         /* 0.0XYZ */
         int offset = 2 - kk;
         memmove(buf + offset, buf, length);
@@ -989,7 +1002,134 @@ write_f64(double f, char* buf, bool allow_nonfinite) {
             *(buf + 1) = '.';
         }
         *(buf + offset + 1) = 'e';
+        if (py_repr) {
+            int32_t e = kk - 1;
+            char *p = buf + offset + 2;
+            *p++ = e < 0 ? '-' : '+';
+            if (e < 0) e = -e;
+            if (e < 10) *p++ = '0';
+            return sign + offset + 3 + (e < 10) + write_exponent(e, p);
+        }
         return sign + offset + 2 + write_exponent(kk - 1, buf + offset + 2);
     }
 }
+
+/* Write a double to buf, requires 24 bytes of space */
+static inline int
+write_f64(double f, char* buf, bool allow_nonfinite) {
+    return write_f64_common(f, buf, allow_nonfinite, false);
+}
+
+/* Write a double to buf formatted like `repr(f)`, with non-finite values as
+ * `nan`, `inf`, and `-inf`. Requires 24 bytes of space. */
+static inline int
+write_f64_repr(double f, char* buf) {
+    return write_f64_common(f, buf, true, true);
+}
+#define MS_FLOAT_PRECISION_MAX 17
+
+static const uint64_t MS_FIXED_POW10[MS_FLOAT_PRECISION_MAX + 1] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+    10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+    100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull
+};
+
+/* Write a double to buf rounded to `precision` decimal places (round half to
+ * even on the exact binary value, like `round(f, precision)` in Python), with
+ * trailing zeros removed. This skips searching for the shortest digits
+ * entirely. Values too large to have that many decimal places in 17 digits
+ * are written by `write_f64`, their shortest form has fewer decimal places
+ * anyway. Requires 24 bytes of space. */
+static inline int
+write_f64_fixed(double f, int precision, char* buf) {
+    const uint64_t bits = double_to_bits(f);
+    const int sign = ((bits >> (DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BITS)) & 1) != 0;
+    const uint64_t ieee_mantissa = bits & ((1ull << DOUBLE_MANTISSA_BITS) - 1);
+    const uint32_t ieee_exponent = (uint32_t) ((bits >> DOUBLE_MANTISSA_BITS) & ((1u << DOUBLE_EXPONENT_BITS) - 1));
+
+    const double abs = sign ? -f : f;
+    if (
+        MS_UNLIKELY(ieee_exponent == ((1 << DOUBLE_EXPONENT_BITS) - 1)) ||
+        !(abs * (double)MS_FIXED_POW10[precision] < 1e17)
+    ) {
+        return write_f64(f, buf, false);
+    }
+
+    /* Compute m = round(abs * 10**precision) */
+    uint64_t c;
+    int32_t q;
+    if (ieee_exponent == 0) {
+        c = ieee_mantissa;
+        q = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS;
+    }
+    else {
+        c = (1ull << DOUBLE_MANTISSA_BITS) | ieee_mantissa;
+        q = (int32_t) ieee_exponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS;
+    }
+    uint64_t m;
+    if (q >= 0) {
+        m = (c << q) * MS_FIXED_POW10[precision];
+    }
+    else {
+        /* The product fits in 110 bits, the remainder is compared against
+         * half of 2**shift to round */
+        uint64_t hi;
+        const uint64_t lo = umul128(c, MS_FIXED_POW10[precision], &hi);
+        const uint32_t shift = (uint32_t) -q;
+        uint64_t rem_hi, rem_lo, half_hi, half_lo;
+        if (shift >= 128) {
+            m = 0;
+            rem_hi = rem_lo = half_lo = 0;
+            half_hi = 1;
+        }
+        else if (shift >= 64) {
+            const uint32_t s = shift - 64;
+            m = hi >> s;
+            rem_hi = s ? hi & ((1ull << s) - 1) : 0;
+            rem_lo = lo;
+            half_hi = s ? 1ull << (s - 1) : 0;
+            half_lo = s ? 0 : 1ull << 63;
+        }
+        else {
+            m = (lo >> shift) | (hi << (64 - shift));
+            rem_hi = 0;
+            rem_lo = lo & ((1ull << shift) - 1);
+            half_hi = 0;
+            half_lo = 1ull << (shift - 1);
+        }
+        if (
+            rem_hi > half_hi ||
+            (rem_hi == half_hi && (rem_lo > half_lo || (rem_lo == half_lo && (m & 1))))
+        ) {
+            m++;
+        }
+    }
+
+    if (sign) {
+        *buf++ = '-';
+    }
+    int length = write_u64(m, buf) - buf;
+    if (length <= precision) {
+        /* 0.00XYZ */
+        int pad = precision + 1 - length;
+        memmove(buf + pad, buf, length);
+        memset(buf, '0', pad);
+        length = precision + 1;
+    }
+    int int_len = length - precision;
+    int frac_len = precision;
+    while (frac_len > 0 && buf[int_len + frac_len - 1] == '0') {
+        frac_len--;
+    }
+    memmove(buf + int_len + 1, buf + int_len, frac_len);
+    buf[int_len] = '.';
+    if (frac_len == 0) {
+        buf[int_len + 1] = '0';
+        frac_len = 1;
+    }
+    return sign + int_len + 1 + frac_len;
+}
+
 #endif // RYU_H
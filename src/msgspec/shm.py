@@ -0,0 +1,302 @@
+from __future__ import annotations
+
+import struct as _struct
+import time as _time
+from multiprocessing import shared_memory as _shared_memory
+from typing import TYPE_CHECKING, Any
+
+from . import msgpack as _msgpack
+from ._core import _atomic_load, _atomic_store
+
+if TYPE_CHECKING:
+    from typing import Callable, Optional
+
+
+__all__ = ("RingBuffer",)
+
+
+def __dir__():
+    return __all__
+
+
+# Layout of the shared memory segment:
+#
+# - A 192 byte header. The write and read counters live on separate cache
+#   lines to avoid false sharing between the writer and reader.
+#   - 0: magic (8 bytes)
+#   - 8: capacity of the data region in bytes (uint64)
+#   - 64: write counter, total bytes committed by the writer (uint64)
+#   - 128: read counter, total bytes released by the reader (uint64)
+# - The data region, holding a sequence of records. Each record is a uint32
+#   length, 4 bytes of padding, then the msgpack encoded message padded to a
+#   multiple of 8 bytes. A length of `_WRAP` marks that the rest of the data
+#   region is unused, and the next record starts at offset 0.
+_MAGIC = b"MSGSPEC\x01"
+_CAPACITY = 8
+_WRITE = 64
+_READ = 128
+_HEADER_SIZE = 192
+_RECORD_HEADER_SIZE = 8
+_WRAP = 0xFFFFFFFF
+_LENGTH = _struct.Struct("<I")
+_UINT64 = _struct.Struct("<Q")
+
+
+def _align(n: int) -> int:
+    return (n + 7) & ~7
+
+
+def _open_shared_memory(name: str) -> _shared_memory.SharedMemory:
+    try:
+        # Added in Python 3.13. Without this the resource tracker may unlink
+        # the segment when an attached process exits.
+        return _shared_memory.SharedMemory(name, track=False)
+    except TypeError:
+        return _shared_memory.SharedMemory(name)
+
+
+class RingBuffer:
+    """A single-producer, single-consumer message queue backed by shared
+    memory.
+
+    Messages are encoded as MessagePack directly into a shared memory ring
+    buffer by the writer, and decoded from it in place by the reader, avoiding
+    the copies through the kernel paid when sending messages over a pipe or
+    socket. The writer and reader synchronize on a pair of counters stored in
+    the shared memory segment.
+
+    Parameters
+    ----------
+    name : str, optional
+        The name of the shared memory segment. Required when attaching to an
+        existing ring buffer. If creating a new ring buffer and not provided,
+        a unique name is generated.
+    create : bool, optional
+        Whether to create a new ring buffer (``True``) or attach to an
+        existing one (``False``, the default).
+    capacity : int, optional
+        The size of the data region in bytes, required when creating a new
+        ring buffer. Rounded up to a multiple of 8. Each message takes 8 bytes
+        of overhead, and may use at most half of the data region.
+    type : type, optional
+        A Python type (in type annotation form) to decode received messages
+        as. If provided, the message will be type checked and decoded as the
+        specified type. Defaults to `Any`, in which case the message will be
+        decoded using the default MessagePack types.
+    enc_hook : callable, optional
+        A callable to call for objects that aren't supported msgspec types when
+        sending messages. See `msgspec.msgpack.Encoder` for more information.
+    dec_hook : callable, optional
+        An optional callback for handling decoding custom types when receiving
+        messages. See `msgspec.msgpack.Decoder` for more information.
+
+    Notes
+    -----
+    Received messages are decoded directly from shared memory. Any
+    `msgspec.Raw` or `memoryview` values in a received message reference the
+    ring buffer, and are only valid until the next call to `recv` or
+    `release`.
+    """
+
+    def __init__(
+        self,
+        name: Optional[str] = None,
+        *,
+        create: bool = False,
+        capacity: int = 0,
+        type: Any = Any,
+        enc_hook: Optional[Callable[[Any], Any]] = None,
+        dec_hook: Optional[Callable[[type, Any], Any]] = None,
+    ):
+        if create:
+            if capacity <= 0:
+                raise ValueError("`capacity` must be > 0 when creating a RingBuffer")
+            capacity = _align(capacity)
+            shm = _shared_memory.SharedMemory(
+                name, create=True, size=_HEADER_SIZE + capacity
+            )
+            buf = shm.buf
+            buf[: len(_MAGIC)] = _MAGIC
+            _UINT64.pack_into(buf, _CAPACITY, capacity)
+            _atomic_store(buf, _READ, 0)
+            _atomic_store(buf, _WRITE, 0)
+        else:
+            if name is None:
+                raise ValueError("`name` is required when attaching to a RingBuffer")
+            shm = _open_shared_memory(name)
+            buf = shm.buf
+            if len(buf) < _HEADER_SIZE or bytes(buf[: len(_MAGIC)]) != _MAGIC:
+                shm.close()
+                raise ValueError(f"{name!r} is not a msgspec RingBuffer")
+            capacity = _UINT64.unpack_from(buf, _CAPACITY)[0]
+
+        self._shm = shm
+        self._name = shm.name
+        self._buf = shm.buf
+        self._data = shm.buf[_HEADER_SIZE : _HEADER_SIZE + capacity]
+        self._capacity = capacity
+        self._encoder = _msgpack.Encoder(enc_hook=enc_hook)
+        self._decoder = _msgpack.Decoder(type, dec_hook=dec_hook)
+        self._scratch = bytearray()
+        self._pending = None
+
+    @property
+    def name(self) -> str:
+        """The name of the shared memory segment"""
+        return self._name
+
+    @property
+    def capacity(self) -> int:
+        """The size of the data region in bytes"""
+        return self._capacity
+
+    def __repr__(self) -> str:
+        return f"RingBuffer({self.name!r}, capacity={self._capacity})"
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __reduce__(self):
+        raise TypeError(
+            "RingBuffer objects can't be pickled, pass `name` to the other "
+            "process and attach to the ring buffer there instead"
+        )
+
+    def _wait(self, ready, timeout):
+        deadline = None if timeout is None else _time.monotonic() + timeout
+        delay = 0.0
+        while not ready():
+            if deadline is not None and _time.monotonic() >= deadline:
+                raise TimeoutError("Timed out waiting on RingBuffer")
+            # Spin briefly before backing off to sleeping, capped at 1 ms
+            _time.sleep(delay)
+            delay = min(delay * 2 or 1e-6, 1e-3)
+
+    def send(self, obj: Any, timeout: Optional[float] = None) -> None:
+        """Send a message, blocking until there's enough free space.
+
+        Parameters
+        ----------
+        obj : Any
+            The object to send.
+        timeout : float, optional
+            The maximum number of seconds to wait for free space. Waits
+            forever if ``None`` (the default). Raises a ``TimeoutError`` if
+            the timeout expires.
+        """
+        scratch = self._scratch
+        self._encoder.encode_into(obj, scratch)
+        n = len(scratch)
+        size = _RECORD_HEADER_SIZE + _align(n)
+        capacity = self._capacity
+        # Limiting records to half the capacity ensures a record that doesn't
+        # fit before the end of the data region always fits at the start.
+        if size > capacity // 2:
+            raise ValueError(
+                f"Message of {n} bytes is too large for a RingBuffer with "
+                f"capacity {capacity}"
+            )
+
+        buf = self._buf
+        write = _atomic_load(buf, _WRITE)
+        pos = write % capacity
+        tail = capacity - pos
+        # If the record doesn't fit before the end of the data region, the
+        # tail is skipped and the record written at the start.
+        needed = size if size <= tail else tail + size
+        self._wait(
+            lambda: write + needed - _atomic_load(buf, _READ) <= capacity, timeout
+        )
+
+        data = self._data
+        if size > tail:
+            _LENGTH.pack_into(data, pos, _WRAP)
+            write += tail
+            pos = 0
+        _LENGTH.pack_into(data, pos, n)
+        start = pos + _RECORD_HEADER_SIZE
+        data[start : start + n] = scratch
+        # Publish the record
+        _atomic_store(buf, _WRITE, write + size)
+
+    def recv(self, timeout: Optional[float] = None) -> Any:
+        """Receive a message, blocking until one is available.
+
+        This also releases the previously received message.
+
+        Parameters
+        ----------
+        timeout : float, optional
+            The maximum number of seconds to wait for a message. Waits forever
+            if ``None`` (the default). Raises a ``TimeoutError`` if the timeout
+            expires.
+
+        Returns
+        -------
+        obj : Any
+            The received message.
+        """
+        self.release()
+        buf = self._buf
+        read = _atomic_load(buf, _READ)
+        self._wait(lambda: _atomic_load(buf, _WRITE) > read, timeout)
+
+        data = self._data
+        capacity = self._capacity
+        pos = read % capacity
+        n = _LENGTH.unpack_from(data, pos)[0]
+        if n == _WRAP:
+            read += capacity - pos
+            pos = 0
+            n = _LENGTH.unpack_from(data, pos)[0]
+        start = pos + _RECORD_HEADER_SIZE
+        # Release the record before propagating any decoding errors
+        self._pending = read + _RECORD_HEADER_SIZE + _align(n)
+        return self._decoder.decode(data[start : start + n])
+
+    def release(self) -> None:
+        """Release the most recently received message, freeing its space in
+        the ring buffer for the writer.
+
+        Any ``memoryview`` or `msgspec.Raw` values in the message are no
+        longer valid after this call.
+        """
+        if self._pending is not None:
+            _atomic_store(self._buf, _READ, self._pending)
+            self._pending = None
+
+    def close(self) -> None:
+        """Close access to the shared memory from this instance.
+
+        The shared memory segment itself is only destroyed once `unlink` is
+        called.
+
+        Raises a ``BufferError`` if any ``memoryview`` or `msgspec.Raw` values
+        referencing the shared memory are still alive. In that case ``close``
+        may be called again once they have been deleted.
+        """
+        if self._shm is None:
+            return
+        self.release()
+        self._data.release()
+        self._buf.release()
+        # Only clear state once the segment is closed, so a failed close can
+        # be retried.
+        self._shm.close()
+        self._buf = self._data = self._shm = None
+
+    def unlink(self) -> None:
+        """Request that the underlying shared memory segment be destroyed.
+
+        This should be called exactly once, typically by the process that
+        created the ring buffer.
+        """
+        if self._shm is not None:
+            self._shm.unlink()
+        else:
+            shm = _open_shared_memory(self._name)
+            shm.unlink()
+            shm.close()
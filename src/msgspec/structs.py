@@ -7,6 +7,8 @@ from ._core import (  # noqa
     Factory as _Factory,
     StructConfig,
     StructMeta,
+    _pickle_list,
+    _rebuild_msgpack_list,
     asdict,
     astuple,
     force_setattr,
@@ -17,6 +19,7 @@ from ._utils import get_class_annotations as _get_class_annotations
 __all__ = (
     "FieldInfo",
     "StructConfig",
+    "StructList",
     "asdict",
     "astuple",
     "fields",
@@ -112,3 +115,28 @@ def fields(type_or_instance: Struct | type[Struct]) -> tuple[FieldInfo]:
         fields.append(field)
 
     return tuple(fields)
+
+
+def _rebuild_struct_list(list_cls, cls, buf):
+    return list_cls(_rebuild_msgpack_list(cls, buf))
+
+
+class StructList(list):
+    """A ``list`` of structs that pickles efficiently.
+
+    With pickle protocol 5 or higher, a list of instances of a single struct
+    type is pickled as one MessagePack message wrapped in a
+    `pickle.PickleBuffer`, rather than pickling each struct individually. This
+    applies even if the individual structs are small. The same restrictions on
+    field values as for pickling a single struct apply; lists that don't
+    qualify are pickled like any other ``list`` subclass.
+    """
+
+    __slots__ = ()
+
+    def __reduce_ex__(self, protocol):
+        if protocol >= 5:
+            res = _pickle_list(self)
+            if res is not None:
+                return (_rebuild_struct_list, (type(self), *res))
+        return super().__reduce_ex__(protocol)
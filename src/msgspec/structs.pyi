@@ -9,6 +9,8 @@ def asdict(struct: Struct) -> dict[str, Any]: ...
 def astuple(struct: Struct) -> tuple[Any, ...]: ...
 def force_setattr(struct: Struct, name: str, value: Any) -> None: ...
 
+class StructList(list[S]): ...
+
 class StructConfig:
     frozen: bool
     eq: bool
@@ -21,6 +23,7 @@ class StructConfig:
     weakref: bool
     dict: bool
     cache_hash: bool
+    unboxed: bool
     tag: Union[str, int, None]
     tag_field: Union[str, None]
 
@@ -1,13 +1,8 @@
 from __future__ import annotations
 
-import datetime as _datetime
 from typing import TYPE_CHECKING, Any, TypeVar, overload
 
-from . import (
-    DecodeError as _DecodeError,
-    convert as _convert,
-    to_builtins as _to_builtins,
-)
+from ._core import toml_decode as _toml_decode, toml_encode as _toml_encode
 
 if TYPE_CHECKING:
     from typing import Callable, Literal, Optional, Type, Union
@@ -22,41 +17,6 @@ def __dir__():
     return __all__
 
 
-def _import_tomllib():
-    try:
-        import tomllib  # type: ignore
-
-        return tomllib
-    except ImportError:
-        pass
-
-    try:
-        import tomli  # type: ignore
-
-        return tomli
-    except ImportError:
-        raise ImportError(
-            "`msgspec.toml.decode` requires `tomli` be installed.\n\n"
-            "Please either `pip` or `conda` install it as follows:\n\n"
-            "  $ python -m pip install tomli   # using pip\n"
-            "  $ conda install tomli           # or using conda"
-        ) from None
-
-
-def _import_tomli_w():
-    try:
-        import tomli_w  # type: ignore
-
-        return tomli_w
-    except ImportError:
-        raise ImportError(
-            "`msgspec.toml.encode` requires `tomli_w` be installed.\n\n"
-            "Please either `pip` or `conda` install it as follows:\n\n"
-            "  $ python -m pip install tomli_w   # using pip\n"
-            "  $ conda install tomli_w           # or using conda"
-        ) from None
-
-
 def encode(
     obj: Any,
     *,
@@ -95,15 +55,7 @@ def encode(
     --------
     decode
     """
-    toml = _import_tomli_w()
-    msg = _to_builtins(
-        obj,
-        builtin_types=(_datetime.datetime, _datetime.date, _datetime.time),
-        str_keys=True,
-        enc_hook=enc_hook,
-        order=order,
-    )
-    return toml.dumps(msg).encode("utf-8")
+    return _toml_encode(obj, enc_hook=enc_hook, order=order)
 
 
 T = TypeVar("T")
@@ -173,26 +125,4 @@ def decode(buf, *, type=Any, strict=True, dec_hook=None):
     --------
     encode
     """
-    toml = _import_tomllib()
-    if isinstance(buf, str):
-        str_buf = buf
-    elif isinstance(buf, (bytes, bytearray)):
-        str_buf = buf.decode("utf-8")
-    else:
-        # call `memoryview` first, since `bytes(1)` is actually valid
-        str_buf = bytes(memoryview(buf)).decode("utf-8")
-    try:
-        obj = toml.loads(str_buf)
-    except toml.TOMLDecodeError as exc:
-        raise _DecodeError(str(exc)) from None
-
-    if type is Any:
-        return obj
-    return _convert(
-        obj,
-        type,
-        builtin_types=(_datetime.datetime, _datetime.date, _datetime.time),
-        str_keys=True,
-        strict=strict,
-        dec_hook=dec_hook,
-    )
+    return _toml_decode(buf, type=type, strict=strict, dec_hook=dec_hook)
@@ -8,6 +8,7 @@ from . import (
     convert as _convert,
     to_builtins as _to_builtins,
 )
+from ._core import _yaml_load
 
 if TYPE_CHECKING:
     from typing import Callable, Literal, Optional, Type, Union
@@ -164,23 +165,30 @@ def decode(buf, *, type=Any, strict=True, dec_hook=None):
 
     Notes
     -----
-    This function requires that the third-party `PyYAML library
-    <https://pyyaml.org/>`_ is installed.
+    Documents using only the common subset of YAML (block and flow
+    collections, plain and quoted scalars on a single line, and literal or
+    folded block scalars) are decoded natively. Documents using other features
+    (anchors, tags, multiple documents, ...) require that the third-party
+    `PyYAML library <https://pyyaml.org/>`_ is installed.
 
     See Also
     --------
     encode
     """
-    yaml = _import_pyyaml("decode")
-    # Use the C extension if available
-    Loader = getattr(yaml, "CSafeLoader", yaml.SafeLoader)
-    if not isinstance(buf, (str, bytes)):
-        # call `memoryview` first, since `bytes(1)` is actually valid
-        buf = bytes(memoryview(buf))
-    try:
-        obj = yaml.load(buf, Loader)
-    except yaml.YAMLError as exc:
-        raise _DecodeError(str(exc)) from None
+    # Try the native parser first, falling back to PyYAML for documents
+    # outside the supported subset.
+    obj = _yaml_load(buf)
+    if obj is NotImplemented:
+        yaml = _import_pyyaml("decode")
+        # Use the C extension if available
+        Loader = getattr(yaml, "CSafeLoader", yaml.SafeLoader)
+        if not isinstance(buf, (str, bytes)):
+            # call `memoryview` first, since `bytes(1)` is actually valid
+            buf = bytes(memoryview(buf))
+        try:
+            obj = yaml.load(buf, Loader)
+        except yaml.YAMLError as exc:
+            raise _DecodeError(str(exc)) from None
 
     if type is Any:
         return obj
@@ -0,0 +1,455 @@
+/* A small extension module for benchmarking the core C kernels in isolation,
+ * measured with hardware performance counters through `perf_event_open`.
+ *
+ * The kernels are static functions in `_core.c`, so that file is included
+ * directly here. The module reuses the `msgspec._core` definition, so it gets
+ * its own module state initialized the same way, independent of the real
+ * module. See `kernels.py` for building and running. */
+#include "_core.c"
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*************************************************************************
+ * Hardware counters                                                     *
+ *************************************************************************/
+
+enum counter_kind {
+    COUNTER_CYCLES,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_BRANCHES,
+    COUNTER_BRANCH_MISSES,
+    COUNTER_CACHE_REFERENCES,
+    COUNTER_CACHE_MISSES,
+    COUNTER_N
+};
+
+static const char *counter_names[COUNTER_N] = {
+    "cycles", "instructions", "branches", "branch_misses",
+    "cache_references", "cache_misses"
+};
+
+typedef struct {
+    int fds[COUNTER_N];
+} Counters;
+
+#ifdef __linux__
+static const uint64_t counter_configs[COUNTER_N] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_REFERENCES,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+
+static void
+counters_close(Counters *c) {
+    for (int i = 0; i < COUNTER_N; i++) {
+        if (c->fds[i] >= 0) close(c->fds[i]);
+        c->fds[i] = -1;
+    }
+}
+
+static int
+counters_open(Counters *c) {
+    for (int i = 0; i < COUNTER_N; i++) c->fds[i] = -1;
+
+    for (int i = 0; i < COUNTER_N; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = counter_configs[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = (
+            PERF_FORMAT_GROUP |
+            PERF_FORMAT_TOTAL_TIME_ENABLED |
+            PERF_FORMAT_TOTAL_TIME_RUNNING
+        );
+        int fd = (int)syscall(
+            SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : c->fds[0], 0
+        );
+        if (fd < 0) {
+            PyErr_Format(
+                PyExc_OSError,
+                "perf_event_open failed for `%s`: %s",
+                counter_names[i], strerror(errno)
+            );
+            counters_close(c);
+            return -1;
+        }
+        c->fds[i] = fd;
+    }
+    return 0;
+}
+
+static inline void
+counters_start(Counters *c) {
+    ioctl(c->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(c->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static inline void
+counters_stop(Counters *c) {
+    ioctl(c->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static int
+counters_read(Counters *c, uint64_t *out) {
+    uint64_t buf[3 + COUNTER_N];
+    ssize_t n = read(c->fds[0], buf, sizeof(buf));
+    if (n != (ssize_t)sizeof(buf)) {
+        PyErr_SetString(PyExc_OSError, "Failed to read performance counters");
+        return -1;
+    }
+    uint64_t enabled = buf[1], running = buf[2];
+    if (running == 0) {
+        PyErr_SetString(
+            PyExc_OSError, "Performance counters were never scheduled"
+        );
+        return -1;
+    }
+    /* Scale for multiplexing, in case the group didn't run the whole time */
+    double scale = (double)enabled / (double)running;
+    for (int i = 0; i < COUNTER_N; i++) {
+        out[i] = (uint64_t)((double)buf[3 + i] * scale);
+    }
+    return 0;
+}
+#else
+static void counters_close(Counters *c) {}
+
+static int
+counters_open(Counters *c) {
+    PyErr_SetString(
+        PyExc_NotImplementedError,
+        "Hardware counters are only supported on Linux"
+    );
+    return -1;
+}
+
+static inline void counters_start(Counters *c) {}
+static inline void counters_stop(Counters *c) {}
+static int counters_read(Counters *c, uint64_t *out) { return -1; }
+#endif
+
+/*************************************************************************
+ * Kernels                                                               *
+ *************************************************************************/
+
+/* Sink for kernel outputs, to keep the compiler from optimizing them away */
+static volatile uint64_t kernel_sink;
+
+typedef struct {
+    MsgspecState *mod;
+    const char *buf;
+    Py_ssize_t size;
+} KernelInput;
+
+/* Each kernel runs once over the whole input, returning -1 on error and the
+ * number of items processed otherwise. */
+typedef Py_ssize_t (*kernel_fn)(KernelInput *);
+
+/* Comma separated JSON numbers */
+static Py_ssize_t
+kernel_parse_number(KernelInput *in) {
+    TypeNode type = {MS_TYPE_ANY};
+    const unsigned char *p = (const unsigned char *)in->buf;
+    const unsigned char *pend = p + in->size;
+    Py_ssize_t count = 0;
+    while (p < pend) {
+        const char *errmsg = NULL;
+        const unsigned char *pout;
+        PyObject *res = parse_number_inline(
+            p, pend, &pout, &errmsg, &type, NULL, true, NULL, false, NULL, NULL, in->mod
+        );
+        if (res == NULL) {
+            if (errmsg != NULL) PyErr_SetString(PyExc_ValueError, errmsg);
+            return -1;
+        }
+        Py_DECREF(res);
+        p = pout + 1; /* Skip ',' */
+        count++;
+    }
+    return count;
+}
+
+/* Concatenated JSON strings */
+static Py_ssize_t
+kernel_decode_string(KernelInput *in) {
+    JSONDecoderState state = {0};
+    state.mod = in->mod;
+    state.input_start = (unsigned char *)in->buf;
+    state.input_pos = state.input_start;
+    state.input_end = state.input_start + in->size;
+    Py_ssize_t count = 0;
+    while (state.input_pos < state.input_end) {
+        char *out;
+        bool is_ascii = true;
+        Py_ssize_t size = json_decode_string_view(&state, &out, &is_ascii);
+        if (size < 0) {
+            count = -1;
+            break;
+        }
+        kernel_sink += size + is_ascii;
+        count++;
+    }
+    PyMem_Free(state.scratch);
+    return count;
+}
+
+/* A single string, encoded with escapes into a reused output buffer */
+static Py_ssize_t
+kernel_encode_string(KernelInput *in) {
+    EncoderState state = {
+        .mod = in->mod,
+        .output_len = 0,
+        .max_output_len = in->size * 6 + 2,
+        .resize_buffer = &ms_resize_bytes
+    };
+    state.output_buffer = PyBytes_FromStringAndSize(NULL, state.max_output_len);
+    if (state.output_buffer == NULL) return -1;
+    state.output_buffer_raw = PyBytes_AS_STRING(state.output_buffer);
+
+    int status = json_encode_cstr_inline(&state, in->buf, in->size);
+    kernel_sink += state.output_len;
+    Py_DECREF(state.output_buffer);
+    return status < 0 ? -1 : 1;
+}
+
+/* Newline separated RFC3339 datetimes */
+static Py_ssize_t
+kernel_decode_datetime(KernelInput *in) {
+    TypeNode type = {MS_TYPE_DATETIME};
+    const char *p = in->buf;
+    const char *pend = p + in->size;
+    Py_ssize_t count = 0;
+    while (p < pend) {
+        const char *end = memchr(p, '\n', pend - p);
+        if (end == NULL) end = pend;
+        PyObject *res = ms_decode_datetime_from_str(in->mod, p, end - p, &type, NULL);
+        if (res == NULL) return -1;
+        Py_DECREF(res);
+        p = end + 1;
+        count++;
+    }
+    return count;
+}
+
+/* An array of doubles */
+static Py_ssize_t
+kernel_write_f64(KernelInput *in) {
+    const double *p = (const double *)in->buf;
+    Py_ssize_t n = in->size / sizeof(double);
+    char buf[32];
+    for (Py_ssize_t i = 0; i < n; i++) {
+        kernel_sink += write_f64(p[i], buf, false);
+    }
+    return n;
+}
+
+/* An array of uint64s */
+static Py_ssize_t
+kernel_write_u64(KernelInput *in) {
+    const uint64_t *p = (const uint64_t *)in->buf;
+    Py_ssize_t n = in->size / sizeof(uint64_t);
+    char buf[24];
+    for (Py_ssize_t i = 0; i < n; i++) {
+        kernel_sink += write_u64(p[i], buf) - buf;
+    }
+    return n;
+}
+
+/* Newline separated keys */
+static Py_ssize_t
+kernel_murmur2(KernelInput *in) {
+    const char *p = in->buf;
+    const char *pend = p + in->size;
+    Py_ssize_t count = 0;
+    while (p < pend) {
+        const char *end = memchr(p, '\n', pend - p);
+        if (end == NULL) end = pend;
+        kernel_sink += murmur2(p, end - p);
+        p = end + 1;
+        count++;
+    }
+    return count;
+}
+
+static const struct {
+    const char *name;
+    kernel_fn func;
+} kernels[] = {
+    {"parse_number", kernel_parse_number},
+    {"decode_string", kernel_decode_string},
+    {"encode_string", kernel_encode_string},
+    {"decode_datetime", kernel_decode_datetime},
+    {"write_f64", kernel_write_f64},
+    {"write_u64", kernel_write_u64},
+    {"murmur2", kernel_murmur2},
+};
+
+#define N_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+static inline uint64_t
+kernels_now(void) {
+#if PY313_PLUS
+    PyTime_t t;
+    if (PyTime_PerfCounterRaw(&t) < 0) return 0;
+    return (uint64_t)t;
+#else
+    return (uint64_t)_PyTime_GetPerfCounter();
+#endif
+}
+
+static int
+kernels_set_u64(PyObject *dict, const char *key, uint64_t x) {
+    PyObject *val = PyLong_FromUnsignedLongLong(x);
+    if (val == NULL) return -1;
+    int status = PyDict_SetItemString(dict, key, val);
+    Py_DECREF(val);
+    return status;
+}
+
+PyDoc_STRVAR(kernels_run__doc__,
+"run(kernel, data, iterations, counters=True)\n"
+"--\n"
+"\n"
+"Run a kernel over ``data`` ``iterations`` times, returning a dict of the\n"
+"number of bytes and items processed, the elapsed time in nanoseconds, and\n"
+"(if ``counters`` is true) hardware counter totals."
+);
+static PyObject *
+kernels_run(PyObject *self, PyObject *args) {
+    const char *name;
+    Py_buffer buffer;
+    Py_ssize_t iterations;
+    int use_counters = 1;
+    kernel_fn func = NULL;
+    uint64_t totals[COUNTER_N];
+    Counters counters;
+    PyObject *out = NULL;
+
+    if (!PyArg_ParseTuple(args, "sy*n|p", &name, &buffer, &iterations, &use_counters)) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < N_KERNELS; i++) {
+        if (strcmp(kernels[i].name, name) == 0) func = kernels[i].func;
+    }
+    if (func == NULL) {
+        PyErr_Format(PyExc_ValueError, "Unknown kernel `%s`", name);
+        goto done;
+    }
+
+    KernelInput in = {
+        .mod = msgspec_get_state(self),
+        .buf = buffer.buf,
+        .size = buffer.len,
+    };
+
+    /* Warm up caches and check for errors before measuring */
+    if (func(&in) < 0) goto done;
+
+    if (use_counters && counters_open(&counters) < 0) goto done;
+    Py_ssize_t items = 0;
+    uint64_t start = kernels_now();
+    if (use_counters) counters_start(&counters);
+    for (Py_ssize_t i = 0; i < iterations; i++) {
+        Py_ssize_t n = func(&in);
+        if (n < 0) break;
+        items += n;
+    }
+    if (use_counters) counters_stop(&counters);
+    uint64_t elapsed = kernels_now() - start;
+    if (use_counters) {
+        int status = PyErr_Occurred() ? -1 : counters_read(&counters, totals);
+        counters_close(&counters);
+        if (status < 0) goto done;
+    }
+    if (PyErr_Occurred()) goto done;
+
+    out = PyDict_New();
+    if (out == NULL) goto done;
+    if (
+        kernels_set_u64(out, "bytes", (uint64_t)buffer.len * iterations) < 0 ||
+        kernels_set_u64(out, "items", items) < 0 ||
+        kernels_set_u64(out, "time_ns", elapsed) < 0
+    ) {
+        Py_CLEAR(out);
+        goto done;
+    }
+    for (int i = 0; use_counters && i < COUNTER_N; i++) {
+        if (kernels_set_u64(out, counter_names[i], totals[i]) < 0) {
+            Py_CLEAR(out);
+            goto done;
+        }
+    }
+
+done:
+    PyBuffer_Release(&buffer);
+    return out;
+}
+
+PyDoc_STRVAR(kernels_names__doc__,
+"names()\n"
+"--\n"
+"\n"
+"Return a list of all kernel names."
+);
+static PyObject *
+kernels_names(PyObject *self, PyObject *args) {
+    PyObject *out = PyList_New(N_KERNELS);
+    if (out == NULL) return NULL;
+    for (size_t i = 0; i < N_KERNELS; i++) {
+        PyObject *name = PyUnicode_FromString(kernels[i].name);
+        if (name == NULL) {
+            Py_DECREF(out);
+            return NULL;
+        }
+        PyList_SET_ITEM(out, i, name);
+    }
+    return out;
+}
+
+static PyMethodDef kernels_methods[] = {
+    {"run", (PyCFunction) kernels_run, METH_VARARGS, kernels_run__doc__},
+    {"names", (PyCFunction) kernels_names, METH_NOARGS, kernels_names__doc__},
+    {NULL, NULL}
+};
+
+static int
+kernels_exec(PyObject *m)
+{
+    return PyModule_AddFunctions(m, kernels_methods);
+}
+
+static PyModuleDef_Slot kernels_slots[] = {
+    {Py_mod_exec, msgspec_exec},
+    {Py_mod_exec, kernels_exec},
+#if PY312_PLUS
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+PyMODINIT_FUNC
+PyInit__kernels(void)
+{
+    /* Reuse the `_core` module definition, so lookups of the module state by
+     * definition work the same */
+    msgspecmodule.m_name = "_kernels";
+    msgspecmodule.m_slots = kernels_slots;
+    return PyModuleDef_Init(&msgspecmodule);
+}
@@ -0,0 +1,220 @@
+"""Benchmark the core C kernels in isolation using hardware performance
+counters (Linux only).
+
+The kernels are compiled into a separate extension module (``_kernels.c``),
+which is built on demand. Run with::
+
+    python -m tests.prof.perf.kernels
+
+For each kernel the following is reported:
+
+- nanoseconds and cycles per byte of input
+- instructions per cycle
+- branch-miss rate (as a fraction of all branches)
+- cache-miss rate (as a fraction of all cache references)
+
+Pass ``--no-counters`` to report only timings when hardware counters aren't
+available (e.g. in most VMs and containers, or when
+``/proc/sys/kernel/perf_event_paranoid`` is greater than 2).
+"""
+
+import argparse
+import array
+import importlib.util
+import json
+import os
+import random
+import sys
+import sysconfig
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.join(HERE, "..", "..", "..", "src", "msgspec")
+
+
+def build(build_dir=None):
+    """Compile and import the ``_kernels`` extension module"""
+    from setuptools import Distribution, Extension
+
+    if build_dir is None:
+        build_dir = tempfile.mkdtemp(prefix="msgspec-kernels-")
+
+    ext = Extension(
+        "_kernels",
+        [os.path.join(HERE, "_kernels.c")],
+        include_dirs=[SRC],
+        extra_compile_args=["-O3"] if sys.platform != "win32" else [],
+    )
+    dist = Distribution({"ext_modules": [ext]})
+    cmd = dist.get_command_obj("build_ext")
+    cmd.build_lib = build_dir
+    cmd.build_temp = os.path.join(build_dir, "temp")
+    cmd.ensure_finalized()
+    cmd.run()
+
+    path = os.path.join(build_dir, "_kernels" + sysconfig.get_config_var("EXT_SUFFIX"))
+    spec = importlib.util.spec_from_file_location("_kernels", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def make_inputs(n=10000, seed=42):
+    """Generate deterministic inputs for each kernel"""
+    rng = random.Random(seed)
+
+    numbers = []
+    for _ in range(n):
+        kind = rng.random()
+        if kind < 0.4:
+            numbers.append(str(rng.randint(-(2**63), 2**63 - 1)))
+        elif kind < 0.6:
+            numbers.append(str(rng.randint(0, 1000)))
+        else:
+            numbers.append(repr(rng.uniform(-1e6, 1e6)))
+
+    words = ["alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf"]
+    strings = []
+    for _ in range(n):
+        s = " ".join(rng.choice(words) for _ in range(rng.randint(1, 8)))
+        kind = rng.random()
+        if kind < 0.1:
+            s += "\\n\\t\\u00e9"
+        elif kind < 0.2:
+            s += " café"
+        strings.append('"%s"' % s)
+
+    text = "".join(
+        rng.choice(words) + rng.choice([" ", " ", " ", "\n", '"', "é"])
+        for _ in range(n)
+    )
+
+    datetimes = [
+        "%04d-%02d-%02dT%02d:%02d:%02d%s%s"
+        % (
+            rng.randint(1970, 2100),
+            rng.randint(1, 12),
+            rng.randint(1, 28),
+            rng.randint(0, 23),
+            rng.randint(0, 59),
+            rng.randint(0, 59),
+            rng.choice(["", ".%06d" % rng.randint(0, 999999)]),
+            rng.choice(["Z", "+01:00", "-05:30"]),
+        )
+        for _ in range(n)
+    ]
+
+    floats = array.array("d", (rng.uniform(-1e6, 1e6) for _ in range(n)))
+    floats.extend(rng.random() * 10 ** rng.randint(-300, 300) for _ in range(n))
+
+    ints = array.array(
+        "Q", (rng.randint(0, 2 ** rng.choice([16, 32, 64]) - 1) for _ in range(n))
+    )
+
+    keys = "\n".join(
+        rng.choice(words) + "_" + rng.choice(words)[: rng.randint(0, 6)]
+        for _ in range(n)
+    )
+
+    return {
+        "parse_number": ",".join(numbers).encode(),
+        "decode_string": "".join(strings).encode(),
+        "encode_string": text.encode(),
+        "decode_datetime": "\n".join(datetimes).encode(),
+        "write_f64": floats.tobytes(),
+        "write_u64": ints.tobytes(),
+        "murmur2": keys.encode(),
+    }
+
+
+def summarize(res):
+    out = {
+        "ns_per_byte": res["time_ns"] / res["bytes"],
+        "ns_per_item": res["time_ns"] / res["items"],
+    }
+    if "cycles" in res:
+        out.update(
+            cycles_per_byte=res["cycles"] / res["bytes"],
+            ipc=res["instructions"] / max(res["cycles"], 1),
+            branch_miss_rate=res["branch_misses"] / max(res["branches"], 1),
+            cache_miss_rate=res["cache_misses"] / max(res["cache_references"], 1),
+        )
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark the core C kernels using hardware counters"
+    )
+    parser.add_argument(
+        "-k",
+        "--kernel",
+        dest="kernels",
+        nargs="*",
+        help="A list of kernels to run. Defaults to all.",
+    )
+    parser.add_argument(
+        "-i",
+        "--iterations",
+        type=int,
+        default=100,
+        help="The number of passes over each input. Defaults to 100.",
+    )
+    parser.add_argument(
+        "-n",
+        "--num-items",
+        type=int,
+        default=10000,
+        help="The number of items in each input. Defaults to 10000.",
+    )
+    parser.add_argument(
+        "--no-counters",
+        action="store_true",
+        help="Only report timings, don't read hardware counters",
+    )
+    parser.add_argument(
+        "--json", action="store_true", help="Output the results as JSON"
+    )
+    args = parser.parse_args()
+
+    kernels = build()
+    names = args.kernels or kernels.names()
+    inputs = make_inputs(args.num_items)
+
+    results = {}
+    for name in names:
+        res = kernels.run(name, inputs[name], args.iterations, not args.no_counters)
+        results[name] = {**res, **summarize(res)}
+
+    if args.json:
+        json.dump(results, sys.stdout, indent=2)
+        return
+
+    columns = ["", "ns/byte", "ns/item"]
+    if not args.no_counters:
+        columns += ["cycles/byte", "IPC", "branch miss %", "cache miss %"]
+    rows = []
+    for name, r in results.items():
+        row = [f"**{name}**", f"{r['ns_per_byte']:.3f}", f"{r['ns_per_item']:.1f}"]
+        if not args.no_counters:
+            row += [
+                f"{r['cycles_per_byte']:.3f}",
+                f"{r['ipc']:.2f}",
+                f"{r['branch_miss_rate'] * 100:.2f}",
+                f"{r['cache_miss_rate'] * 100:.2f}",
+            ]
+        rows.append(tuple(row))
+    widths = tuple(max(max(map(len, x)), len(c)) for x, c in zip(zip(*rows), columns))
+    row_template = ("|" + (" %%-%ds |" * len(columns))) % widths
+    header = row_template % tuple(columns)
+    bar_underline = "+%s+" % "+".join("=" * (w + 2) for w in widths)
+    bar = "+%s+" % "+".join("-" * (w + 2) for w in widths)
+    parts = [bar, header, bar_underline]
+    for r in rows:
+        parts.append(row_template % r)
+        parts.append(bar)
+    print("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main()
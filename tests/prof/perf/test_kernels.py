@@ -0,0 +1,57 @@
+import sys
+
+import pytest
+
+from .kernels import build, make_inputs, summarize
+
+pytestmark = pytest.mark.skipif(
+    not sys.platform.startswith("linux"), reason="Hardware counters require Linux"
+)
+
+
+@pytest.fixture(scope="module")
+def kernels(tmp_path_factory):
+    return build(str(tmp_path_factory.mktemp("kernels")))
+
+
+@pytest.fixture(scope="module")
+def inputs():
+    return make_inputs(100)
+
+
+@pytest.mark.parametrize(
+    "name",
+    [
+        "parse_number",
+        "decode_string",
+        "encode_string",
+        "decode_datetime",
+        "write_f64",
+        "write_u64",
+        "murmur2",
+    ],
+)
+def test_kernel(kernels, inputs, name):
+    res = kernels.run(name, inputs[name], 2, False)
+    assert res["bytes"] == 2 * len(inputs[name])
+    assert res["items"] > 0
+    assert summarize(res)["ns_per_byte"] > 0
+
+
+def test_kernel_counters(kernels, inputs):
+    try:
+        res = kernels.run("murmur2", inputs["murmur2"], 2)
+    except OSError as exc:
+        pytest.skip(f"Hardware counters unavailable: {exc}")
+    assert res["cycles"] > 0
+    assert res["instructions"] > 0
+    summary = summarize(res)
+    assert 0 <= summary["branch_miss_rate"] <= 1
+
+
+def test_kernel_errors(kernels):
+    with pytest.raises(ValueError, match="Unknown kernel"):
+        kernels.run("missing", b"", 1, False)
+
+    with pytest.raises(ValueError):
+        kernels.run("parse_number", b"1,x", 1, False)
@@ -278,6 +278,15 @@ def check_struct_cache_hash() -> None:
     reveal_type(t)  # assert "Test" in typ
 
 
+def check_struct_unboxed() -> None:
+    class Test(msgspec.Struct, unboxed=True):
+        x: int
+        y: float
+
+    t = Test(1, 2.0)
+    reveal_type(t)  # assert "Test" in typ
+
+
 def check_struct_tag_tag_field() -> None:
     class Test1(msgspec.Struct, tag=None):
         pass
@@ -363,6 +372,7 @@ def check_struct_config() -> None:
     reveal_type(config.weakref)  # assert "bool" in typ
     reveal_type(config.dict)  # assert "bool" in typ
     reveal_type(config.cache_hash)  # assert "bool" in typ
+    reveal_type(config.unboxed)  # assert "bool" in typ
     reveal_type(config.tag)  # assert "str" in typ and "int" in typ
     reveal_type(config.tag_field)  # assert "str" in typ
 
@@ -419,6 +429,7 @@ def check_defstruct_config_options() -> None:
         dict=True,
         weakref=True,
         cache_hash=True,
+        unboxed=True,
         gc=False,
         tag="mytag",
         tag_field="mytagfield",
@@ -463,6 +474,16 @@ def check_astuple() -> None:
     reveal_type(o[0])  # assert "Any" in typ
 
 
+def check_StructList() -> None:
+    class Test(msgspec.Struct):
+        x: int
+
+    o = msgspec.structs.StructList([Test(1), Test(2)])
+    reveal_type(o)  # assert "StructList" in typ
+    reveal_type(o[0])  # assert "Test" in typ
+    x: list[Test] = o
+
+
 def check_force_setattr() -> None:
     class Point(msgspec.Struct, frozen=True):
         x: int
@@ -581,6 +602,17 @@ def check_raw_pass_to_decode() -> None:
     res2 = msgspec.msgpack.decode(r)
 
 
+##########################################################
+# Vector                                                 #
+##########################################################
+
+def check_vector_decode() -> None:
+    res = msgspec.json.decode(b"[1.5]", type=msgspec.Vector[float])
+    reveal_type(res)  # assert "array" in typ and "float" in typ
+    res2 = msgspec.msgpack.decode(b"", type=msgspec.Vector[int])
+    reveal_type(res2)  # assert "array" in typ and "int" in typ
+
+
 ##########################################################
 # MessagePack                                            #
 ##########################################################
@@ -659,6 +691,11 @@ def check_msgpack_decode_from_buffer() -> None:
     msgspec.toml.decode(memoryview(msg))
 
 
+def check_msgpack_decode_file() -> None:
+    o = msgspec.msgpack.decode_file("test.msgpack", type=List[int])
+    reveal_type(o)  # assert ("List" in typ or "list" in typ) and "int" in typ
+
+
 def check_msgpack_decode_typed_union() -> None:
     o: Union[int, str] = msgspec.msgpack.decode(b"", type=Union[int, str])
     reveal_type(o)  # assert "int" in typ and "str" in typ
@@ -696,6 +733,26 @@ def check_msgpack_Encoder_uuid_format() -> None:
     reveal_type(enc.uuid_format)  # assert all(s in typ.lower() for s in ("canonical", "hex", "bytes"))
 
 
+def check_json_Encoder_float_precision() -> None:
+    enc = msgspec.json.Encoder(float_precision=3)
+    msgspec.json.Encoder(float_precision=None)
+    reveal_type(enc.float_precision)  # assert "int" in typ and "None" in typ
+
+
+def check_msgpack_Encoder_float_format() -> None:
+    enc = msgspec.msgpack.Encoder(float_format="float64")
+    msgspec.msgpack.Encoder(float_format="float32")
+    msgspec.msgpack.Encoder(float_format="smallest")
+    reveal_type(enc.float_format)  # assert all(s in typ.lower() for s in ("float64", "float32", "smallest"))
+
+
+def check_msgpack_typed_array_ext() -> None:
+    enc = msgspec.msgpack.Encoder(typed_array_ext=1)
+    dec = msgspec.msgpack.Decoder(memoryview, typed_array_ext=1)
+    reveal_type(enc.typed_array_ext)  # assert "int" in typ and "None" in typ
+    reveal_type(dec.typed_array_ext)  # assert "int" in typ and "None" in typ
+
+
 def check_msgpack_decode_dec_hook() -> None:
     def dec_hook(typ: Type, obj: Any) -> Any:
         return typ(obj)
@@ -814,6 +871,33 @@ def check_json_Decoder_decode_lines_typed() -> None:
     reveal_type(o)  # assert "list" in typ.lower() and "int" in typ.lower()
 
 
+def check_json_Decoder_decode_columns() -> None:
+    class Point(msgspec.Struct):
+        x: int
+
+    dec = msgspec.json.Decoder(List[Point])
+    o = dec.decode_columns(b'[{"x": 1}]')
+    reveal_type(o)  # assert "dict" in typ.lower() and "array" in typ.lower()
+
+
+def check_json_Decoder_decode_arrow() -> None:
+    class Point(msgspec.Struct):
+        x: int
+
+    dec = msgspec.json.Decoder(List[Point])
+    o = dec.decode_arrow(b'[{"x": 1}]')
+    reveal_type(o)  # assert "ArrowBatch" in typ
+    reveal_type(len(o))  # assert "int" in typ
+
+
+def check_json_Encoder_encode_columns() -> None:
+    enc = msgspec.json.Encoder()
+    b = enc.encode_columns({"x": [1, 2], "y": memoryview(b"ab")})
+    b2 = enc.encode_columns({"x": [1, 2]}, layout="lines")
+    reveal_type(b)  # assert "bytes" in typ
+    reveal_type(b2)  # assert "bytes" in typ
+
+
 def check_json_decode_any() -> None:
     b = msgspec.json.encode([1, 2, 3])
     o = msgspec.json.decode(b)
@@ -828,6 +912,16 @@ def check_json_decode_typed() -> None:
     reveal_type(o)  # assert ("List" in typ or "list" in typ) and "int" in typ
 
 
+def check_json_decode_file() -> None:
+    o = msgspec.json.decode_file("test.json", type=List[int])
+    reveal_type(o)  # assert ("List" in typ or "list" in typ) and "int" in typ
+
+
+def check_json_iter_lines_file() -> None:
+    for o in msgspec.json.iter_lines_file("test.ndjson", type=List[int]):
+        reveal_type(o)  # assert ("List" in typ or "list" in typ) and "int" in typ
+
+
 def check_json_decode_typed_union() -> None:
     o: Union[int, str] = msgspec.json.decode(b"", type=Union[int, str])
     reveal_type(o)  # assert "int" in typ and "str" in typ
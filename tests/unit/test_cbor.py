@@ -0,0 +1,571 @@
+from __future__ import annotations
+
+import datetime
+import decimal
+import math
+import uuid
+from typing import Any, Dict, List, Optional, Union
+
+import pytest
+
+import msgspec
+from msgspec import cbor
+
+UTC = datetime.timezone.utc
+
+
+# Examples from RFC 8949, Appendix A
+RFC_DECODE_EXAMPLES = [
+    ("00", 0),
+    ("01", 1),
+    ("0a", 10),
+    ("17", 23),
+    ("1818", 24),
+    ("1819", 25),
+    ("1864", 100),
+    ("1903e8", 1000),
+    ("1a000f4240", 1000000),
+    ("1b000000e8d4a51000", 1000000000000),
+    ("1bffffffffffffffff", 18446744073709551615),
+    ("c249010000000000000000", 18446744073709551616),
+    ("3bffffffffffffffff", -18446744073709551616),
+    ("c349010000000000000000", -18446744073709551617),
+    ("20", -1),
+    ("29", -10),
+    ("3863", -100),
+    ("3903e7", -1000),
+    ("f90000", 0.0),
+    ("f98000", -0.0),
+    ("f93c00", 1.0),
+    ("fb3ff199999999999a", 1.1),
+    ("f93e00", 1.5),
+    ("f97bff", 65504.0),
+    ("fa47c35000", 100000.0),
+    ("fa7f7fffff", 3.4028234663852886e38),
+    ("fb7e37e43c8800759c", 1.0e300),
+    ("f90001", 5.960464477539063e-8),
+    ("f90400", 0.00006103515625),
+    ("f9c400", -4.0),
+    ("fbc010666666666666", -4.1),
+    ("f97c00", float("inf")),
+    ("f9fc00", float("-inf")),
+    ("fa7f800000", float("inf")),
+    ("fb7ff0000000000000", float("inf")),
+    ("f4", False),
+    ("f5", True),
+    ("f6", None),
+    ("f7", None),
+    (
+        "c074323031332d30332d32315432303a30343a30305a",
+        datetime.datetime(2013, 3, 21, 20, 4, tzinfo=UTC),
+    ),
+    ("c11a514b67b0", datetime.datetime(2013, 3, 21, 20, 4, tzinfo=UTC)),
+    (
+        "c1fb41d452d9ec200000",
+        datetime.datetime(2013, 3, 21, 20, 4, 0, 500000, tzinfo=UTC),
+    ),
+    ("d74401020304", b"\x01\x02\x03\x04"),
+    ("d818456449455446", b"dIETF"),
+    ("d82076687474703a2f2f7777772e6578616d706c652e636f6d", "http://www.example.com"),
+    ("40", b""),
+    ("4401020304", b"\x01\x02\x03\x04"),
+    ("60", ""),
+    ("6161", "a"),
+    ("6449455446", "IETF"),
+    ("62225c", '"\\'),
+    ("62c3bc", "ü"),
+    ("63e6b0b4", "水"),
+    ("64f0908591", "\U00010151"),
+    ("80", []),
+    ("83010203", [1, 2, 3]),
+    ("8301820203820405", [1, [2, 3], [4, 5]]),
+    (
+        "98190102030405060708090a0b0c0d0e0f101112131415161718181819",
+        list(range(1, 26)),
+    ),
+    ("a0", {}),
+    ("a201020304", {1: 2, 3: 4}),
+    ("a26161016162820203", {"a": 1, "b": [2, 3]}),
+    ("826161a161626163", ["a", {"b": "c"}]),
+    (
+        "a56161614161626142616361436164614461656145",
+        {"a": "A", "b": "B", "c": "C", "d": "D", "e": "E"},
+    ),
+    ("5f42010243030405ff", b"\x01\x02\x03\x04\x05"),
+    ("7f657374726561646d696e67ff", "streaming"),
+    ("9fff", []),
+    ("9f018202039f0405ffff", [1, [2, 3], [4, 5]]),
+    ("9f01820203820405ff", [1, [2, 3], [4, 5]]),
+    ("83018202039f0405ff", [1, [2, 3], [4, 5]]),
+    ("83019f0203ff820405", [1, [2, 3], [4, 5]]),
+    (
+        "9f0102030405060708090a0b0c0d0e0f101112131415161718181819ff",
+        list(range(1, 26)),
+    ),
+    ("bf61610161629f0203ffff", {"a": 1, "b": [2, 3]}),
+    ("826161bf61626163ff", ["a", {"b": "c"}]),
+    ("bf6346756ef563416d7421ff", {"Fun": True, "Amt": -2}),
+]
+
+
+# Examples from RFC 8949, Appendix A that msgspec encodes identically
+RFC_ENCODE_EXAMPLES = [
+    ("00", 0),
+    ("17", 23),
+    ("1818", 24),
+    ("1903e8", 1000),
+    ("1a000f4240", 1000000),
+    ("1b000000e8d4a51000", 1000000000000),
+    ("1bffffffffffffffff", 18446744073709551615),
+    ("c249010000000000000000", 18446744073709551616),
+    ("3bffffffffffffffff", -18446744073709551616),
+    ("c349010000000000000000", -18446744073709551617),
+    ("20", -1),
+    ("3903e7", -1000),
+    ("fb3ff199999999999a", 1.1),
+    ("fb7e37e43c8800759c", 1.0e300),
+    ("f4", False),
+    ("f5", True),
+    ("f6", None),
+    (
+        "c074323031332d30332d32315432303a30343a30305a",
+        datetime.datetime(2013, 3, 21, 20, 4, tzinfo=UTC),
+    ),
+    ("4401020304", b"\x01\x02\x03\x04"),
+    ("60", ""),
+    ("62c3bc", "ü"),
+    ("8301820203820405", [1, [2, 3], [4, 5]]),
+    (
+        "98190102030405060708090a0b0c0d0e0f101112131415161718181819",
+        list(range(1, 26)),
+    ),
+    ("a201020304", {1: 2, 3: 4}),
+    ("a26161016162820203", {"a": 1, "b": [2, 3]}),
+]
+
+
+class Person(msgspec.Struct):
+    first: str
+    last: str
+    age: int
+    prefect: bool = False
+
+
+class PersonArray(msgspec.Struct, array_like=True):
+    first: str
+    last: str
+    age: int
+    prefect: bool = False
+
+
+class Cat(msgspec.Struct, tag=True):
+    name: str
+
+
+class Dog(msgspec.Struct, tag=True):
+    name: str
+    good: bool = True
+
+
+class TestRFCExamples:
+    @pytest.mark.parametrize("msg, sol", RFC_DECODE_EXAMPLES)
+    def test_decode(self, msg, sol):
+        res = cbor.decode(bytes.fromhex(msg))
+        assert res == sol
+        assert type(res) is type(sol)
+        if isinstance(sol, float) and sol == 0:
+            assert math.copysign(1, res) == math.copysign(1, sol)
+
+    def test_decode_nan(self):
+        for msg in ["f97e00", "fa7fc00000", "fb7ff8000000000000"]:
+            assert math.isnan(cbor.decode(bytes.fromhex(msg)))
+
+    @pytest.mark.parametrize("sol, obj", RFC_ENCODE_EXAMPLES)
+    def test_encode(self, sol, obj):
+        assert cbor.encode(obj).hex() == sol
+
+
+class TestEncodeFunction:
+    def test_encode(self):
+        assert cbor.decode(cbor.encode([1, "two", 3.0])) == [1, "two", 3.0]
+
+    def test_encode_bad_arguments(self):
+        with pytest.raises(TypeError, match="Missing 1 required argument"):
+            cbor.encode()
+
+        with pytest.raises(TypeError, match="Extra positional"):
+            cbor.encode(1, 2)
+
+        with pytest.raises(TypeError, match="enc_hook must be callable"):
+            cbor.encode(1, enc_hook="bad")
+
+    def test_encode_large_object(self):
+        data = b"x" * 70000
+        assert cbor.decode(cbor.encode(data)) == data
+
+    def test_encode_enc_hook(self):
+        class Foo:
+            pass
+
+        with pytest.raises(TypeError, match="Encoding objects of type Foo"):
+            cbor.encode(Foo())
+
+        assert cbor.encode(Foo(), enc_hook=lambda x: "foo") == cbor.encode("foo")
+
+    def test_encode_ext_unsupported(self):
+        with pytest.raises(
+            TypeError, match="Encoding objects of type msgspec.msgpack.Ext"
+        ):
+            cbor.encode(msgspec.msgpack.Ext(1, b"test"))
+
+
+class TestDecodeFunction:
+    def test_decode_type_keyword(self):
+        msg = cbor.encode([1, 2, 3])
+        assert cbor.decode(msg, type=List[int]) == [1, 2, 3]
+
+        with pytest.raises(msgspec.ValidationError, match=r"Expected `str`, got `int`"):
+            cbor.decode(msg, type=List[str])
+
+    def test_decode_parse_arguments_errors(self):
+        msg = cbor.encode(1)
+        with pytest.raises(TypeError, match="Missing 1 required argument"):
+            cbor.decode()
+
+        with pytest.raises(TypeError, match="Extra keyword arguments"):
+            cbor.decode(msg, ext_hook=None)
+
+        with pytest.raises(TypeError, match="tag_hook must be callable"):
+            cbor.decode(msg, tag_hook=1)
+
+    def test_decode_with_trailing_characters_errors(self):
+        msg = cbor.encode([1, 2, 3]) + b"\x00"
+
+        with pytest.raises(msgspec.DecodeError, match="trailing characters"):
+            cbor.decode(msg)
+
+    @pytest.mark.parametrize(
+        "msg", ["", "19", "1903", "63ab", "83", "a1", "9f01", "c1", "5f41"]
+    )
+    def test_decode_truncated(self, msg):
+        with pytest.raises(msgspec.DecodeError, match="truncated"):
+            cbor.decode(bytes.fromhex(msg))
+
+    @pytest.mark.parametrize(
+        "msg, err",
+        [
+            ("1c", "invalid initial byte"),
+            ("1f", "invalid initial byte"),
+            ("ff", "unexpected break"),
+            ("8201ff", "unexpected break"),
+            ("f0", "unsupported simple value"),
+            ("5f6161ff", "invalid string chunk"),
+            ("7f7f6161ffff", "invalid string chunk"),
+        ],
+    )
+    def test_decode_malformed(self, msg, err):
+        with pytest.raises(msgspec.DecodeError, match=f"CBOR data is malformed: {err}"):
+            cbor.decode(bytes.fromhex(msg))
+
+    def test_decode_file(self, tmp_path):
+        path = tmp_path / "test.cbor"
+        path.write_bytes(cbor.encode({"x": [1, 2, 3]}))
+        assert cbor.decode_file(path) == {"x": [1, 2, 3]}
+        assert cbor.decode_file(str(path), type=Dict[str, List[int]]) == {
+            "x": [1, 2, 3]
+        }
+
+
+class TestEncoderMisc:
+    def test_encoder_init_errors(self):
+        with pytest.raises(TypeError):
+            cbor.Encoder(typed_array_ext=1)
+
+        with pytest.raises(TypeError, match="enc_hook must be callable"):
+            cbor.Encoder(enc_hook=1)
+
+    def test_encoder_attributes(self):
+        enc = cbor.Encoder(uuid_format="bytes", order="sorted")
+        assert enc.uuid_format == "bytes"
+        assert enc.order == "sorted"
+        assert enc.decimal_format == "string"
+        assert enc.enc_hook is None
+
+    def test_encode_into(self):
+        enc = cbor.Encoder()
+        buf = bytearray(b"abc")
+        enc.encode_into([1, 2], buf, 3)
+        assert buf == b"abc\x82\x01\x02"
+
+    @pytest.mark.parametrize(
+        "x",
+        [
+            2**63,
+            -(2**63) - 1,
+            2**64 - 1,
+            -(2**64),
+            2**64,
+            -(2**64) - 1,
+            2**200,
+            -(2**200),
+        ],
+    )
+    def test_encode_integer_limits(self, x):
+        msg = cbor.encode(x)
+        assert cbor.decode(msg) == x
+        assert cbor.decode(msg, type=int) == x
+
+    def test_encode_bignum_typed(self):
+        msg = cbor.encode(2**70)
+        assert cbor.decode(msg, type=float) == float(2**70)
+        assert cbor.decode(msg, type=decimal.Decimal) == decimal.Decimal(2**70)
+        with pytest.raises(msgspec.ValidationError, match="Expected `str`, got `int`"):
+            cbor.decode(msg, type=str)
+
+    def test_encode_sets_sorted(self):
+        msg = cbor.Encoder(order="deterministic").encode({3, 1, 2})
+        assert msg == cbor.encode([1, 2, 3])
+
+    def test_encode_omit_defaults_fixes_header(self):
+        class Ex(msgspec.Struct, omit_defaults=True):
+            x: int
+            y: int = 0
+
+        fields = {f"f{i}": (int, 0) for i in range(30)}
+        Big = msgspec.defstruct("Big", [(k, t, d) for k, (t, d) in fields.items()])
+        Big.__struct_config__  # noqa: B018
+
+        BigOmit = msgspec.defstruct(
+            "BigOmit",
+            [(k, t, d) for k, (t, d) in fields.items()],
+            omit_defaults=True,
+        )
+
+        assert cbor.encode(Ex(1)) == cbor.encode({"x": 1})
+        msg = cbor.encode(BigOmit(f3=1))
+        assert cbor.decode(msg) == {"f3": 1}
+        assert cbor.decode(msg, type=Big) == Big(f3=1)
+
+
+class TestDecoderMisc:
+    def test_decoder_attributes(self):
+        def tag_hook(tag, value):
+            pass
+
+        dec = cbor.Decoder(List[int], strict=False, tag_hook=tag_hook)
+        assert dec.type == List[int]
+        assert dec.strict is False
+        assert dec.dec_hook is None
+        assert dec.tag_hook is tag_hook
+
+    def test_decoder_init_errors(self):
+        with pytest.raises(TypeError):
+            cbor.Decoder(ext_hook=lambda *args: None)
+
+        with pytest.raises(TypeError, match="tag_hook must be callable"):
+            cbor.Decoder(tag_hook=1)
+
+    def test_decoder_repr(self):
+        assert repr(cbor.Decoder(int)) == "msgspec.cbor.Decoder(<class 'int'>)"
+
+    def test_tag_hook(self):
+        msg = bytes.fromhex("d82076687474703a2f2f7777772e6578616d706c652e636f6d")
+
+        def tag_hook(tag, value):
+            return (tag, value)
+
+        dec = cbor.Decoder(tag_hook=tag_hook)
+        assert dec.decode(msg) == (32, "http://www.example.com")
+
+        # Typed decoding ignores the tag
+        dec = cbor.Decoder(str, tag_hook=tag_hook)
+        assert dec.decode(msg) == "http://www.example.com"
+
+        # Supported tags don't call the hook
+        msg = cbor.encode(datetime.datetime(2020, 1, 2, tzinfo=UTC))
+        assert cbor.decode(msg, tag_hook=tag_hook) == datetime.datetime(
+            2020, 1, 2, tzinfo=UTC
+        )
+
+    def test_self_describe_tag(self):
+        assert cbor.decode(b"\xd9\xd9\xf7" + cbor.encode([1, 2])) == [1, 2]
+
+    def test_decode_memoryview(self):
+        msg = cbor.encode(b"abcde")
+        res = cbor.decode(msg, type=memoryview)
+        assert isinstance(res, memoryview)
+        assert bytes(res) == b"abcde"
+
+        res = cbor.decode(bytes.fromhex("5f42010243030405ff"), type=memoryview)
+        assert bytes(res) == b"\x01\x02\x03\x04\x05"
+
+    def test_decode_raw(self):
+        msg = bytes.fromhex("a2617882019f0203ff6179c11a514b67b0")
+
+        class Ex(msgspec.Struct):
+            x: msgspec.Raw
+            y: Any
+
+        res = cbor.decode(msg, type=Ex)
+        assert cbor.decode(res.x) == [1, [2, 3]]
+        assert res.y == datetime.datetime(2013, 3, 21, 20, 4, tzinfo=UTC)
+
+
+class TestTypedDecoder:
+    @pytest.mark.parametrize("array_like", [False, True])
+    def test_struct_roundtrip(self, array_like):
+        cls = PersonArray if array_like else Person
+        obj = cls("harry", "potter", 13)
+        msg = cbor.encode(obj)
+        assert cbor.decode(msg, type=cls) == obj
+        assert cbor.Decoder(cls).decode(msg) == obj
+
+    def test_struct_indefinite_map(self):
+        msg = bytes.fromhex(
+            "bf"
+            "656669727374656861727279"  # "first": "harry"
+            "646c6173747f63706f7463746572ff"  # "last": "pot" "ter"
+            "636167650d"  # "age": 13
+            "ff"
+        )
+        assert cbor.decode(msg, type=Person) == Person("harry", "potter", 13)
+
+    def test_struct_errors(self):
+        msg = cbor.encode({"first": "harry", "last": "potter", "age": "13"})
+        with pytest.raises(
+            msgspec.ValidationError, match=r"Expected `int`, got `str` - at `\$.age`"
+        ):
+            cbor.decode(msg, type=Person)
+
+        msg = cbor.encode({"first": "harry", "last": "potter"})
+        with pytest.raises(
+            msgspec.ValidationError, match="Object missing required field `age`"
+        ):
+            cbor.decode(msg, type=Person)
+
+    @pytest.mark.parametrize("order", [None, "sorted"])
+    def test_tagged_union(self, order):
+        enc = cbor.Encoder(order=order)
+        dec = cbor.Decoder(List[Union[Cat, Dog]])
+        msg = [Cat("tom"), Dog("fido", False)]
+        assert dec.decode(enc.encode(msg)) == msg
+
+        # Tag not first
+        msg = cbor.encode({"name": "tom", "type": "Cat"})
+        assert cbor.decode(msg, type=Union[Cat, Dog]) == Cat("tom")
+
+        msg = cbor.encode({"type": "Bird", "name": "tweety"})
+        with pytest.raises(
+            msgspec.ValidationError, match=r"Invalid value 'Bird' - at `\$.type`"
+        ):
+            cbor.decode(msg, type=Union[Cat, Dog])
+
+    def test_datetime(self):
+        aware = datetime.datetime(2020, 1, 2, 3, 4, 5, 123456, tzinfo=UTC)
+        naive = aware.replace(tzinfo=None)
+
+        assert cbor.encode(aware)[0] == 0xC0
+        assert cbor.decode(cbor.encode(aware)) == aware
+        assert cbor.decode(cbor.encode(aware), type=datetime.datetime) == aware
+
+        # Naive datetimes encode as untagged strings
+        assert cbor.decode(cbor.encode(naive)) == naive.isoformat()
+        assert cbor.decode(cbor.encode(naive), type=datetime.datetime) == naive
+
+        # Epoch-based datetimes
+        msg = bytes.fromhex("c11a514b67b0")
+        assert cbor.decode(msg, type=datetime.datetime) == datetime.datetime(
+            2013, 3, 21, 20, 4, tzinfo=UTC
+        )
+        with pytest.raises(msgspec.ValidationError, match="Invalid epoch timestamp"):
+            cbor.decode(bytes.fromhex("c16161"))
+
+    def test_date_time_timedelta(self):
+        d = datetime.date(2020, 1, 2)
+        assert cbor.decode(cbor.encode(d)) == d
+        assert cbor.decode(cbor.encode(d), type=datetime.date) == d
+
+        t = datetime.time(1, 2, 3)
+        assert cbor.decode(cbor.encode(t), type=datetime.time) == t
+
+        td = datetime.timedelta(days=1, seconds=2)
+        assert cbor.decode(cbor.encode(td), type=datetime.timedelta) == td
+
+    @pytest.mark.parametrize("uuid_format", ["canonical", "hex", "bytes"])
+    def test_uuid(self, uuid_format):
+        u = uuid.uuid4()
+        msg = cbor.Encoder(uuid_format=uuid_format).encode(u)
+        assert cbor.decode(msg, type=uuid.UUID) == u
+        if uuid_format == "bytes":
+            assert msg[:2] == b"\xd8\x25"
+            assert cbor.decode(msg) == u
+
+    @pytest.mark.parametrize(
+        "d", ["273.15", "-1E+3", "0", "-0.000001", "12345678901234567890123.45"]
+    )
+    def test_decimal_fraction(self, d):
+        d = decimal.Decimal(d)
+        msg = cbor.Encoder(decimal_format="number").encode(d)
+        assert msg[0] == 0xC4
+        res = cbor.decode(msg)
+        assert res == d
+        assert str(res) == str(d)
+        assert cbor.decode(msg, type=decimal.Decimal) == d
+        assert cbor.decode(msg, type=float) == float(d)
+
+    def test_decimal_fraction_examples(self):
+        # From RFC 8949, section 3.4.4
+        msg = bytes.fromhex("c48221196ab3")
+        assert cbor.decode(msg) == decimal.Decimal("273.15")
+
+        with pytest.raises(msgspec.ValidationError, match="Invalid CBOR decimal"):
+            cbor.decode(bytes.fromhex("c483010203"))
+
+    @pytest.mark.parametrize(
+        "msg",
+        [
+            # Exponents of -2**64 and 2**64 - 1
+            "c4823bffffffffffffffff01",
+            "c4821bffffffffffffffff01",
+            # A bignum exponent of 2**64
+            "c482c24901000000000000000001",
+        ],
+    )
+    @pytest.mark.parametrize("typ", [Any, decimal.Decimal, float])
+    def test_decimal_fraction_out_of_range(self, msg, typ):
+        # Wrapped in a list to check the error path
+        msg = b"\x82\x01" + bytes.fromhex(msg)
+        with pytest.raises(
+            msgspec.ValidationError,
+            match=r"CBOR decimal fraction out of range - at `\$\[1\]`",
+        ):
+            cbor.decode(msg, type=List[typ])
+
+    def test_decimal_nonfinite(self):
+        enc = cbor.Encoder(decimal_format="number")
+        assert math.isnan(cbor.decode(enc.encode(decimal.Decimal("nan"))))
+        assert cbor.decode(enc.encode(decimal.Decimal("inf"))) == float("inf")
+
+    def test_dict_keys(self):
+        msg = cbor.encode({1: "a", 2: "b"})
+        assert cbor.decode(msg, type=Dict[int, str]) == {1: "a", 2: "b"}
+
+        # Arrays as keys decode as tuples
+        msg = bytes.fromhex("a1820102f5")
+        assert cbor.decode(msg) == {(1, 2): True}
+
+    def test_vector(self):
+        msg = cbor.encode([1.5, 2, 3.25])
+        assert list(cbor.decode(msg, type=msgspec.Vector[float])) == [1.5, 2, 3.25]
+
+    def test_optional_and_union(self):
+        dec = cbor.Decoder(List[Optional[Union[int, str]]])
+        assert dec.decode(cbor.encode([1, None, "a"])) == [1, None, "a"]
+
+    def test_half_and_single_floats_typed(self):
+        assert cbor.decode(bytes.fromhex("f93e00"), type=float) == 1.5
+        assert cbor.decode(bytes.fromhex("fa47c35000"), type=float) == 100000.0
+        with pytest.raises(
+            msgspec.ValidationError, match="Expected `int`, got `float`"
+        ):
+            cbor.decode(bytes.fromhex("f93e00"), type=int)
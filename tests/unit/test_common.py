@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import array
 import base64
 import collections
 import datetime
@@ -7,6 +8,7 @@ import decimal
 import enum
 import gc
 import sys
+import threading
 import typing
 import uuid
 import weakref
@@ -45,6 +47,9 @@ from msgspec import UNSET, Meta, Struct, UnsetType, ValidationError
 
 UTC = datetime.timezone.utc
 
+# The "u" typecode is deprecated in favor of "w" on 3.13+
+UNICODE_TYPECODE = "w" if sys.version_info >= (3, 13) else "u"
+
 PY310 = sys.version_info[:2] >= (3, 10)
 PY311 = sys.version_info[:2] >= (3, 11)
 PY312 = sys.version_info[:2] >= (3, 12)
@@ -61,12 +66,14 @@ def assert_eq(x, y):
     assert type(x) is type(y)
 
 
-@pytest.fixture(params=["json", "msgpack"])
+@pytest.fixture(params=["json", "msgpack", "cbor"])
 def proto(request):
     if request.param == "json":
         return msgspec.json
     elif request.param == "msgpack":
         return msgspec.msgpack
+    elif request.param == "cbor":
+        return msgspec.cbor
 
 
 try:
@@ -1809,6 +1816,73 @@ class TestStructOmitDefaults:
             assert res == sol
 
 
+@pytest.mark.skipif(sys.maxsize < 2**32, reason="Unboxed fields need 64 bit")
+class TestStructUnboxed:
+    @pytest.mark.parametrize("array_like", [False, True])
+    def test_encode_decode_unboxed(self, proto, array_like):
+        class Test(Struct, unboxed=True, array_like=array_like):
+            a: int
+            b: float
+            c: bool
+            d: str = ""
+
+        for obj in [
+            Test(1, 2.5, True),
+            Test(-(2**63), -1e300, False, "x"),
+            Test(2**63 - 1, 0.0, True, "y"),
+        ]:
+            msg = proto.encode(obj)
+            sol = proto.encode(
+                msgspec.structs.astuple(obj)
+                if array_like
+                else msgspec.structs.asdict(obj)
+            )
+            assert msg == sol
+            assert proto.decode(msg, type=Test) == obj
+
+    def test_encode_unboxed_sorted(self, proto):
+        class Test(Struct, unboxed=True):
+            b: float
+            a: int
+            c: str = "x"
+
+        enc = proto.Encoder(order="sorted")
+        assert enc.encode(Test(1.5, 2)) == proto.encode({"a": 2, "b": 1.5, "c": "x"})
+
+    def test_unboxed_omit_defaults(self, proto):
+        class Test(Struct, unboxed=True, omit_defaults=True):
+            a: int = 1000
+            b: float = 1.5
+            c: bool = False
+
+        cases = [
+            (Test(), {}),
+            (Test(1001), {"a": 1001}),
+            (Test(b=-0.0), {"b": -0.0}),
+            (Test(c=True), {"c": True}),
+        ]
+        for obj, sol in cases:
+            assert proto.decode(proto.encode(obj)) == sol
+
+    def test_decode_unboxed_defaults(self, proto):
+        class Test(Struct, unboxed=True):
+            a: int
+            b: float = 1
+            c: bool = True
+
+        assert proto.decode(proto.encode({"a": 1}), type=Test) == Test(1, 1.0, True)
+
+        with pytest.raises(msgspec.ValidationError, match="missing required field `a`"):
+            proto.decode(proto.encode({"b": 1.0}), type=Test)
+
+    def test_decode_unboxed_int_out_of_range(self, proto):
+        class Test(Struct, unboxed=True):
+            a: int
+
+        with pytest.raises(msgspec.ValidationError, match=r"at `\$.a`"):
+            proto.decode(proto.encode({"a": 2**63}), type=Test)
+
+
 class TestStructForbidUnknownFields:
     def test_forbid_unknown_fields(self, proto):
         class Test(Struct, forbid_unknown_fields=True):
@@ -3153,12 +3227,12 @@ class TestDate:
     def test_encode_date(self, proto):
         # All fields, zero padded
         x = datetime.date(1, 2, 3)
-        s = proto.decode(proto.encode(x))
+        s = proto.decode(proto.encode(x), type=str)
         assert s == "0001-02-03"
 
         # All fields, no zeros
         x = datetime.date(1234, 12, 31)
-        s = proto.decode(proto.encode(x))
+        s = proto.decode(proto.encode(x), type=str)
         assert s == "1234-12-31"
 
     @pytest.mark.parametrize(
@@ -3633,7 +3707,7 @@ class TestUUID:
         assert proto.Encoder(uuid_format="canonical").uuid_format == "canonical"
         assert proto.Encoder(uuid_format="hex").uuid_format == "hex"
 
-        if proto is msgspec.msgpack:
+        if proto is not msgspec.json:
             assert proto.Encoder(uuid_format="bytes").uuid_format == "bytes"
         else:
             with pytest.raises(
@@ -3921,7 +3995,11 @@ class TestDecimal:
     def test_Encoder_encode_decimal_number(self, proto):
         enc = proto.Encoder(decimal_format="number")
         d = decimal.Decimal("1.5")
-        sol = enc.encode(float(d))
+        if proto is msgspec.cbor:
+            # CBOR encodes decimals exactly as decimal fractions (tag 4)
+            sol = b"\xc4\x82\x20\x0f"
+        else:
+            sol = enc.encode(float(d))
 
         assert enc.encode(d) == sol
 
@@ -4022,6 +4100,120 @@ class TestAbstractTypes:
             proto.decode(proto.encode({"a": "b"}), type=typ[str, int])
 
 
+class TestVector:
+    @pytest.mark.parametrize(
+        "typ, typecode, values",
+        [
+            (int, "q", [0, 1, -1, 127, -129, 2**40, 2**63 - 1, -(2**63)]),
+            (float, "d", [0.0, 1.5, -2.25, 1e300, -1e-300, 2.0**60]),
+        ],
+    )
+    def test_vector_roundtrip(self, proto, typ, typecode, values):
+        msg = proto.encode(values)
+        res = proto.decode(msg, type=msgspec.Vector[typ])
+        assert_eq(res, array.array(typecode, values))
+        assert proto.decode(proto.encode(res)) == values
+
+    def test_vector_float_from_int(self, proto):
+        msg = proto.encode([1, -2, 2**63, 3.5])
+        res = proto.decode(msg, type=msgspec.Vector[float])
+        assert_eq(res, array.array("d", [1.0, -2.0, 2.0**63, 3.5]))
+
+    @pytest.mark.parametrize("size", [0, 1, 7, 8, 9, 100, 1000])
+    def test_vector_sizes(self, proto, size):
+        values = [i * 1.5 for i in range(size)]
+        res = proto.decode(proto.encode(values), type=msgspec.Vector[float])
+        assert_eq(res, array.array("d", values))
+
+    @pytest.mark.parametrize("value", [2**63, 2**64 - 1])
+    def test_vector_int_out_of_range(self, proto, value):
+        with pytest.raises(
+            ValidationError, match=r"Integer value out of range - at `\$\[1\]`"
+        ):
+            proto.decode(proto.encode([1, value]), type=msgspec.Vector[int])
+
+    @pytest.mark.parametrize(
+        "value, got", [(1.5, "float"), ("a", "str"), ([1], "array")]
+    )
+    def test_vector_wrong_element_type(self, proto, value, got):
+        msg = proto.encode([1, value])
+        with pytest.raises(
+            ValidationError, match=f"Expected `int`, got `{got}` - at `\\$\\[1\\]`"
+        ):
+            proto.decode(msg, type=msgspec.Vector[int])
+
+    def test_vector_wrong_type(self, proto):
+        with pytest.raises(ValidationError, match="Expected `array`, got `object`"):
+            proto.decode(proto.encode({}), type=msgspec.Vector[int])
+
+    def test_vector_lax(self, proto):
+        msg = proto.encode(["1", 2.0, 3])
+        res = proto.decode(msg, type=msgspec.Vector[int], strict=False)
+        assert_eq(res, array.array("q", [1, 2, 3]))
+
+    def test_vector_length_constraints(self, proto):
+        typ = Annotated[msgspec.Vector[float], Meta(min_length=1, max_length=2)]
+        assert_eq(proto.decode(proto.encode([1.0]), type=typ), array.array("d", [1.0]))
+        for values in [[], [1.0, 2.0, 3.0]]:
+            with pytest.raises(ValidationError, match="Expected `array` of length"):
+                proto.decode(proto.encode(values), type=typ)
+
+    def test_vector_in_struct(self, proto):
+        class Ex(Struct):
+            x: msgspec.Vector[float]
+            y: Optional[msgspec.Vector[int]] = None
+
+        msg = proto.encode({"x": [1.5, 2.5], "y": [1, 2]})
+        res = proto.decode(msg, type=Ex)
+        assert_eq(res.x, array.array("d", [1.5, 2.5]))
+        assert_eq(res.y, array.array("q", [1, 2]))
+        assert proto.decode(proto.encode(res), type=Ex) == res
+
+    @pytest.mark.skipif(not PY312, reason="array.array is generic on 3.12+")
+    def test_array_array_annotation(self, proto):
+        res = proto.decode(proto.encode([1, 2]), type=array.array[int])
+        assert_eq(res, array.array("q", [1, 2]))
+
+    @pytest.mark.parametrize("typ", [str, bool, List[float]])
+    def test_vector_invalid_parameter(self, proto, typ):
+        with pytest.raises(TypeError, match="Vector types must be parametrized"):
+            proto.Decoder(msgspec.Vector[typ])
+
+    def test_vector_bare_errors(self, proto):
+        with pytest.raises(TypeError, match="Vector types must be parametrized"):
+            proto.Decoder(msgspec.Vector)
+
+    def test_vector_union_with_array_like_errors(self, proto):
+        with pytest.raises(TypeError, match="more than one array-like type"):
+            proto.Decoder(Union[List[int], msgspec.Vector[int]])
+
+    def test_vector_not_instantiable(self):
+        with pytest.raises(TypeError):
+            msgspec.Vector()
+
+    @pytest.mark.parametrize("typecode", "bBhHiIlLqQfd")
+    def test_encode_array_array(self, proto, typecode):
+        arr = array.array(typecode, [1, 2, 3])
+        res = proto.decode(proto.encode(arr))
+        assert res == [1, 2, 3]
+        assert all(type(x) is (float if typecode in "fd" else int) for x in res)
+
+    def test_encode_array_array_unsupported_typecode(self, proto):
+        with pytest.raises(TypeError, match="Only `array.array` objects"):
+            proto.encode(array.array(UNICODE_TYPECODE, "ab"))
+
+    def test_encode_array_array_unsupported_typecode_enc_hook(self, proto):
+        def enc_hook(obj):
+            assert isinstance(obj, array.array)
+            return obj.tounicode()
+
+        msg = proto.encode(array.array(UNICODE_TYPECODE, "ab"), enc_hook=enc_hook)
+        assert proto.decode(msg) == "ab"
+        # Numeric arrays are still encoded natively
+        msg = proto.encode(array.array("q", [1, 2]), enc_hook=enc_hook)
+        assert proto.decode(msg) == [1, 2]
+
+
 class TestUnset:
     def test_unset_type_annotation_ignored(self, proto):
         class Ex(Struct):
@@ -4241,6 +4433,45 @@ class TestOrder:
         sol = proto.encode({"x": 1, "y": 2, "z": 0})
         assert res == sol
 
+    @pytest.mark.skipif(sys.maxsize < 2**32, reason="Unboxed fields need 64 bit")
+    def test_order_struct_rename_and_unboxed(self, proto):
+        class Ex(
+            Struct, rename={"a": "z_a", "b": "y_b"}, omit_defaults=True, unboxed=True
+        ):
+            a: int
+            b: float = 1.5
+            c: int = 0
+            d: bool = False
+
+        res = proto.encode(Ex(1), order="sorted")
+        sol = proto.encode({"z_a": 1})
+        assert res == sol
+
+        res = proto.encode(Ex(1, 2.5, 3, True), order="sorted")
+        sol = proto.encode({"c": 3, "d": True, "y_b": 2.5, "z_a": 1})
+        assert res == sol
+
+    def test_order_dict_repeated_shapes(self, proto, rand):
+        # Mappings with the same set of keys in the same order share a cached
+        # sort order. Check shapes that only differ in key contents or order.
+        shapes = [
+            ["b", "a", "c"],
+            ["a", "b", "c"],
+            ["c", "b", "a"],
+            ["b", "a", "d"],
+            ["long_shared_prefix_b", "long_shared_prefix_a"],
+            ["long_shared_prefix_a", "long_shared_prefix_b"],
+            ["long_shared_prefix_b_x", "long_shared_prefix_a_x"],
+            ["é", "e", "ü", "💯", ""],
+            [f"x{i}" for i in range(40, 0, -1)],
+        ]
+        for _ in range(3):
+            for keys in shapes:
+                msg = {k: i for i, k in enumerate(keys)}
+                res = proto.encode(msg, order="deterministic")
+                sol = proto.encode(dict(sorted(msg.items())))
+                assert res == sol
+
     @pytest.mark.parametrize("n", [0, 2, 3, 7, 15, 16, 17, 32, 100, 500, 1000, 10000])
     def test_order_sort_implementation(self, rand, n):
         keys = [f"x_{i}" for i in range(n)]
@@ -4573,3 +4804,362 @@ class TestLax:
         typ = Union[int, float, bool, None, datetime.date]
         msg = proto.encode(x)
         assert_eq(proto.decode(msg, type=typ, strict=False), sol)
+
+
+class TestDecodeColumns:
+    @pytest.fixture(params=["json", "msgpack"])
+    def proto(self, request):
+        # The columnar APIs aren't supported by CBOR
+        return getattr(msgspec, request.param)
+
+    class Row(Struct):
+        x: int
+        y: float
+        flag: bool
+        label: str
+        opt: Optional[int] = None
+        z: int = 5
+        tags: List[str] = []
+
+    def test_decode_columns(self, proto):
+        rows = [
+            self.Row(1, 1.5, True, "a", 2, 3, ["x"]),
+            self.Row(-2, 2.0, False, "b"),
+        ]
+        msg = proto.encode(rows)
+        res = proto.Decoder(List[self.Row]).decode_columns(msg)
+        assert list(res) == ["x", "y", "flag", "label", "opt", "z", "tags"]
+        assert_eq(res["x"], array.array("q", [1, -2]))
+        assert_eq(res["y"], array.array("d", [1.5, 2.0]))
+        assert_eq(res["flag"], array.array("b", [1, 0]))
+        assert_eq(res["z"], array.array("q", [3, 5]))
+        assert res["label"] == ["a", "b"]
+        assert res["opt"] == [2, None]
+        assert res["tags"] == [["x"], []]
+        # Mutable defaults aren't shared
+        assert res["tags"][1] is not self.Row.__struct_defaults__[-1]
+
+    def test_decode_columns_empty(self, proto):
+        res = proto.Decoder(List[self.Row]).decode_columns(proto.encode([]))
+        assert_eq(res["x"], array.array("q"))
+        assert_eq(res["y"], array.array("d"))
+        assert_eq(res["flag"], array.array("b"))
+        assert res["label"] == []
+
+    def test_decode_columns_matches_decode(self, proto):
+        class Ex(Struct, tag=True, rename="camel"):
+            field_one: int
+            field_two: Annotated[float, Meta(ge=0)] = 1.0
+
+        rows = [Ex(i, i / 2) for i in range(100)]
+        msg = proto.encode(rows)
+        dec = proto.Decoder(List[Ex])
+        res = dec.decode_columns(msg)
+        assert list(res["field_one"]) == [r.field_one for r in dec.decode(msg)]
+        assert list(res["field_two"]) == [r.field_two for r in dec.decode(msg)]
+
+    def test_decode_columns_int_out_of_range(self, proto):
+        class Ex(Struct):
+            x: int
+
+        dec = proto.Decoder(List[Ex])
+        for x in [2**63, 2**64 - 1]:
+            msg = proto.encode([{"x": 1}, {"x": x}, {"x": 3}])
+            with pytest.raises(
+                ValidationError,
+                match=r"Integer value out of range for `int64` column - at `\$\[1\].x`",
+            ):
+                dec.decode_columns(msg)
+
+        msg = proto.encode([{"x": 2**63 - 1}, {"x": -(2**63)}])
+        res = dec.decode_columns(msg)
+        assert_eq(res["x"], array.array("q", [2**63 - 1, -(2**63)]))
+
+    def test_decode_columns_mistyped_default(self, proto):
+        class Ex(Struct):
+            x: int = None
+
+        res = proto.Decoder(List[Ex]).decode_columns(proto.encode([{"x": 1}, {}]))
+        assert res["x"] == [1, None]
+
+    def test_decode_columns_array_like_and_post_init(self, proto):
+        class Ex1(Struct, array_like=True):
+            x: int
+            y: str
+
+        class Ex2(Struct):
+            x: int
+
+            def __post_init__(self):
+                self.x *= 2
+
+        res = proto.Decoder(List[Ex1]).decode_columns(proto.encode([[1, "a"]]))
+        assert_eq(res["x"], array.array("q", [1]))
+        assert res["y"] == ["a"]
+
+        res = proto.Decoder(List[Ex2]).decode_columns(proto.encode([{"x": 1}]))
+        assert_eq(res["x"], array.array("q", [2]))
+
+    @pytest.mark.parametrize(
+        "msg, err",
+        [
+            ({}, "Expected `array`, got `object`"),
+            ([1], r"Expected `object`, got `int` - at `\$\[0\]`"),
+            ([{"x": 1}, {}], r"missing required field `x` - at `\$\[1\]`"),
+            ([{"x": "bad"}], r"Expected `int`, got `str` - at `\$\[0\].x`"),
+            ([{"x": -1}], r"Expected `int` >= 0 - at `\$\[0\].x`"),
+            ([{"x": 1, "y": 2}], r"Object contains unknown field `y` - at `\$\[0\]`"),
+            ([{"x": 1}] * 3, r"Expected `array` of length <= 2"),
+        ],
+    )
+    def test_decode_columns_errors(self, proto, msg, err):
+        class Ex(Struct, forbid_unknown_fields=True):
+            x: Annotated[int, Meta(ge=0)]
+
+        dec = proto.Decoder(Annotated[List[Ex], Meta(max_length=2)])
+        with pytest.raises(ValidationError, match=err):
+            dec.decode_columns(proto.encode(msg))
+
+    @pytest.mark.parametrize("typ", [int, List[int], Optional[List[Row]]])
+    def test_decode_columns_unsupported_type(self, proto, typ):
+        dec = proto.Decoder(typ)
+        with pytest.raises(TypeError, match="requires a decoder of type"):
+            dec.decode_columns(proto.encode([]))
+
+
+class TestDecodeArrow:
+    @pytest.fixture(params=["json", "msgpack"])
+    def proto(self, request):
+        # The columnar APIs aren't supported by CBOR
+        return getattr(msgspec, request.param)
+
+    class Row(Struct):
+        x: int
+        y: float
+        flag: bool
+        label: str
+        data: bytes = b""
+        opt_int: Optional[int] = None
+        opt_bool: Optional[bool] = None
+        opt_str: Optional[str] = None
+
+    def make_rows(self, n):
+        return [
+            self.Row(
+                i,
+                i / 2,
+                i % 3 == 0,
+                "\u00e9" * i,
+                bytes([i]),
+                i if i % 2 else None,
+                True if i % 2 else None,
+                str(i) if i % 4 else None,
+            )
+            for i in range(n)
+        ]
+
+    @pytest.mark.parametrize("n", [0, 1, 37])
+    def test_decode_arrow(self, proto, n):
+        pa = pytest.importorskip("pyarrow")
+        rows = self.make_rows(n)
+        batch = proto.Decoder(List[self.Row]).decode_arrow(proto.encode(rows))
+        assert len(batch) == n
+        assert isinstance(batch, msgspec.ArrowBatch)
+
+        rb = pa.record_batch(batch)
+        rb.validate(full=True)
+        assert rb.schema == pa.schema(
+            [
+                pa.field("x", pa.int64(), nullable=False),
+                pa.field("y", pa.float64(), nullable=False),
+                pa.field("flag", pa.bool_(), nullable=False),
+                pa.field("label", pa.large_string(), nullable=False),
+                pa.field("data", pa.large_binary(), nullable=False),
+                pa.field("opt_int", pa.int64()),
+                pa.field("opt_bool", pa.bool_()),
+                pa.field("opt_str", pa.large_string()),
+            ]
+        )
+        assert rb.to_pylist() == [msgspec.structs.asdict(r) for r in rows]
+
+    def test_decode_arrow_export_multiple_times(self, proto):
+        pa = pytest.importorskip("pyarrow")
+        rows = self.make_rows(10)
+        batch = proto.Decoder(List[self.Row]).decode_arrow(proto.encode(rows))
+        sol = [msgspec.structs.asdict(r) for r in rows]
+        rb = pa.record_batch(batch)
+        table = pa.table(batch)
+        assert pa.schema(batch) == rb.schema
+        # Exported arrays keep the buffers alive
+        del batch
+        gc.collect()
+        assert rb.to_pylist() == sol
+        assert table.to_pylist() == sol
+
+    def test_decode_arrow_release_from_other_thread(self, proto):
+        pa = pytest.importorskip("pyarrow")
+        rows = self.make_rows(10)
+        batch = proto.Decoder(List[self.Row]).decode_arrow(proto.encode(rows))
+        rb = pa.record_batch(batch)
+        del batch
+        sol = [msgspec.structs.asdict(r) for r in rows]
+        box = [rb]
+        del rb
+
+        def release():
+            assert box.pop().to_pylist() == sol
+            gc.collect()
+
+        t = threading.Thread(target=release)
+        t.start()
+        t.join()
+        assert not box
+
+    def test_decode_arrow_repr(self, proto):
+        class Ex(Struct):
+            x: int
+            y: str
+
+        batch = proto.Decoder(List[Ex]).decode_arrow(proto.encode([Ex(1, "a")]))
+        assert repr(batch) == "msgspec.ArrowBatch(num_rows=1, columns=['x', 'y'])"
+
+    def test_decode_arrow_int_out_of_range(self, proto):
+        class Ex(Struct):
+            x: int
+
+        msg = proto.encode([{"x": 1}, {"x": 2**63}])
+        with pytest.raises(ValidationError, match=r"out of range .* - at `\$\[1\].x`"):
+            proto.Decoder(List[Ex]).decode_arrow(msg)
+
+    def test_decode_arrow_validation_error(self, proto):
+        class Ex(Struct):
+            x: Annotated[str, Meta(max_length=2)]
+
+        msg = proto.encode([{"x": "ab"}, {"x": "abc"}])
+        with pytest.raises(ValidationError, match=r"length <= 2 - at `\$\[1\].x`"):
+            proto.Decoder(List[Ex]).decode_arrow(msg)
+
+    def test_decode_arrow_unsupported_field_type(self, proto):
+        class Ex(Struct):
+            x: int
+            y: List[int]
+
+        dec = proto.Decoder(List[Ex])
+        with pytest.raises(TypeError, match="doesn't support field `y`"):
+            dec.decode_arrow(proto.encode([]))
+
+    def test_decode_arrow_unsupported_type(self, proto):
+        dec = proto.Decoder(List[int])
+        with pytest.raises(TypeError, match="`decode_arrow` requires a decoder"):
+            dec.decode_arrow(proto.encode([]))
+
+
+class TestEncodeColumns:
+    @pytest.fixture(params=["json", "msgpack"])
+    def proto(self, request):
+        # The columnar APIs aren't supported by CBOR
+        return getattr(msgspec, request.param)
+
+    @pytest.mark.parametrize(
+        "typecode, values",
+        [
+            ("b", [-(2**7), 2**7 - 1]),
+            ("B", [0, 2**8 - 1]),
+            ("h", [-(2**15), 2**15 - 1]),
+            ("H", [0, 2**16 - 1]),
+            ("i", [-(2**31), 2**31 - 1]),
+            ("I", [0, 2**32 - 1]),
+            ("q", [-(2**63), 2**63 - 1]),
+            ("Q", [0, 2**64 - 1]),
+            ("f", [1.5, -0.25]),
+            ("d", [0.1, -1e300]),
+        ],
+    )
+    def test_encode_columns_buffer(self, proto, typecode, values):
+        cols = {"x": array.array(typecode, values)}
+        msg = proto.Encoder().encode_columns(cols)
+        assert proto.decode(msg) == [{"x": v} for v in values]
+
+    def test_encode_columns_bool_buffer(self, proto):
+        cols = {"x": memoryview(bytes([1, 0])).cast("?")}
+        msg = proto.Encoder().encode_columns(cols)
+        assert_eq(proto.decode(msg), [{"x": True}, {"x": False}])
+
+    def test_encode_columns_mixed(self, proto):
+        cols = {
+            "x": array.array("q", [1, 2, 3]),
+            "y": ["a", None, {"nested": [1]}],
+            "z": (1.5, uuid.UUID(int=0), datetime.date(2024, 1, 2)),
+        }
+        enc = proto.Encoder()
+        sol = [
+            {"x": cols["x"][i], "y": cols["y"][i], "z": cols["z"][i]} for i in range(3)
+        ]
+        assert enc.encode_columns(cols) == enc.encode(sol)
+
+    def test_encode_columns_large_first_row(self, proto):
+        # The size extrapolated from a large first row is capped, rather than
+        # trying to allocate (len(first) * nrows) bytes
+        cols = {"a": ["x" * 2_000_000] + [1] * 200_000}
+        enc = proto.Encoder()
+        msg = enc.encode_columns(cols)
+        assert msg == enc.encode([{"a": v} for v in cols["a"]])
+
+    def test_encode_columns_roundtrip_decode_columns(self, proto):
+        class Ex(Struct):
+            x: int
+            y: float
+            z: str
+
+        rows = [Ex(i, i / 2, str(i)) for i in range(50)]
+        dec = proto.Decoder(List[Ex])
+        cols = dec.decode_columns(proto.encode(rows))
+        assert dec.decode(proto.Encoder().encode_columns(cols)) == rows
+
+    def test_encode_columns_empty(self, proto):
+        enc = proto.Encoder()
+        assert proto.decode(enc.encode_columns({})) == []
+        assert proto.decode(enc.encode_columns({"x": [], "y": array.array("d")})) == []
+
+    def test_encode_columns_enc_hook(self, proto):
+        class Custom:
+            pass
+
+        enc = proto.Encoder(enc_hook=lambda obj: "custom")
+        msg = enc.encode_columns({"x": [Custom()]})
+        assert proto.decode(msg) == [{"x": "custom"}]
+
+    def test_encode_columns_sorted(self, proto):
+        enc = proto.Encoder(order="sorted")
+        msg = enc.encode_columns({"b": [1], "a": [2], "c": [3]})
+        assert list(proto.decode(msg)[0]) == ["a", "b", "c"]
+
+    def test_encode_columns_column_resized(self, proto):
+        values = [1, 2, 3]
+
+        def enc_hook(obj):
+            values.clear()
+            return 1
+
+        enc = proto.Encoder(enc_hook=enc_hook)
+        with pytest.raises(RuntimeError, match="changed size during encoding"):
+            enc.encode_columns({"x": [object(), 2, 3], "y": values})
+
+    @pytest.mark.parametrize(
+        "cols, err_type, err",
+        [
+            ([], TypeError, "`columns` must be a dict"),
+            ({1: [1]}, TypeError, "Column names must be strings"),
+            ({"a": [1], "b": [1, 2]}, ValueError, "column 'b' has length 2"),
+            ({"a": "ab"}, TypeError, "must be a list, tuple, or 1-dimensional"),
+            ({"a": memoryview(b"ab").cast("c")}, TypeError, "unsupported buffer"),
+            (
+                {"a": memoryview(bytes(4)).cast("B", shape=[2, 2])},
+                TypeError,
+                "unsupported buffer",
+            ),
+        ],
+    )
+    def test_encode_columns_errors(self, proto, cols, err_type, err):
+        with pytest.raises(err_type, match=err):
+            proto.Encoder().encode_columns(cols)
@@ -1,3 +1,4 @@
+import array
 import datetime
 import decimal
 import enum
@@ -1026,6 +1027,37 @@ class TestSequences:
         with pytest.raises(ValidationError, match="Expected `array` of length 3"):
             convert((1, "two"), typ)
 
+    @pytest.mark.parametrize("in_type", [list, tuple, "array"])
+    def test_vector(self, in_type):
+        if in_type == "array":
+            msg = array.array("i", [1, 2, 3])
+        else:
+            msg = in_type([1, 2, 3])
+        res = convert(msg, msgspec.Vector[float])
+        assert res == array.array("d", [1.0, 2.0, 3.0])
+        assert res.typecode == "d"
+
+        res = convert(msg, msgspec.Vector[int])
+        assert res == array.array("q", [1, 2, 3])
+        assert res.typecode == "q"
+
+    def test_vector_errors(self):
+        with pytest.raises(
+            ValidationError, match=r"Expected `int`, got `str` - at `\$\[1\]`"
+        ):
+            convert([1, "two"], msgspec.Vector[int])
+
+        with pytest.raises(
+            ValidationError, match=r"Expected `int`, got `float` - at `\$\[0\]`"
+        ):
+            convert(array.array("d", [1.5]), msgspec.Vector[int])
+
+        with pytest.raises(ValidationError, match="Integer value out of range"):
+            convert([2**63], msgspec.Vector[int])
+
+        with pytest.raises(ValidationError, match="Expected `array`, got `set`"):
+            convert({1, 2}, msgspec.Vector[int])
+
 
 class TestNamedTuple:
     def test_namedtuple_no_defaults(self):
@@ -1668,6 +1700,42 @@ class TestStruct:
         with pytest.raises(ValidationError, match=r"Expected `str` - at `key` in `\$`"):
             convert({"age": 1, 1: 2}, self.Account)
 
+    def test_dict_to_struct_key_order_and_identity(self):
+        class Ex(Struct, tag=True):
+            a: int
+            b: int
+            c: int = 3
+
+        sol = Ex(1, 2)
+        # Keys matched by identity, in order and out of order
+        assert convert({"type": "Ex", "a": 1, "b": 2}, Ex) == sol
+        assert convert({"b": 2, "a": 1, "type": "Ex"}, Ex) == sol
+        # Keys equal to, but not the same objects as, the field names
+        keys = ["".join(k) for k in ["type", "a", "b"]]
+        assert convert(dict(zip(keys, ["Ex", 1, 2])), Ex) == sol
+        assert convert(dict(zip(keys[::-1], [2, 1, "Ex"])), Ex) == sol
+
+    def test_from_attributes_getattr_errors_treated_as_missing(self):
+        class Obj:
+            a = 1
+
+            @property
+            def b(self):
+                raise ValueError("Oh no!")
+
+        class Ex(Struct):
+            a: int
+            b: int = 2
+
+        assert convert(Obj(), Ex, from_attributes=True) == Ex(1, 2)
+
+        class Ex2(Struct):
+            a: int
+            b: int
+
+        with pytest.raises(ValidationError, match="missing required field `b`"):
+            convert(Obj(), Ex2, from_attributes=True)
+
     def test_from_attributes_option_disables_attribute_coercion(self):
         class Bad:
             def __init__(self):
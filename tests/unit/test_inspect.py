@@ -263,6 +263,17 @@ def test_sequence(kw, typ, info_type, has_item_type):
     assert mi.type_info(typ) == sol
 
 
+@pytest.mark.parametrize("kw", [{}, dict(min_length=1, max_length=3)])
+@pytest.mark.parametrize(
+    "item, item_info", [(int, mi.IntType()), (float, mi.FloatType())]
+)
+def test_vector(kw, item, item_info):
+    typ = msgspec.Vector[item]
+    if kw:
+        typ = Annotated[typ, Meta(**kw)]
+    assert mi.type_info(typ) == mi.VectorType(item_type=item_info, **kw)
+
+
 @pytest.mark.parametrize("typ", [Tuple, tuple])
 def test_tuple(typ):
     assert mi.type_info(typ[()]) == mi.TupleType(())
@@ -1,5 +1,7 @@
 import datetime
+import subprocess
 import sys
+import textwrap
 
 import pytest
 
@@ -36,3 +38,123 @@ def test_decode_naive_time(proto):
         proto.decode(msg, type=datetime.time)
     end = sys.getrefcount(None)
     assert start == end
+
+
+def test_msgspec_types_are_immutable():
+    for cls in [
+        msgspec.StructMeta,
+        msgspec.Raw,
+        msgspec.json.Decoder,
+        msgspec.UnsetType,
+    ]:
+        with pytest.raises(TypeError):
+            type(cls).__setattr__(cls, "attr", 1)
+
+
+@pytest.mark.skipif(
+    sys.version_info < (3, 13), reason="datetime is per-interpreter from 3.13"
+)
+def test_isolated_subinterpreter():
+    pytest.importorskip("_interpreters")
+    code = textwrap.dedent(
+        """
+        import datetime
+        import msgspec
+
+        class Point(msgspec.Struct, tag=True):
+            x: int
+            y: "int | msgspec.UnsetType" = msgspec.UNSET
+
+        p = Point(1)
+        assert msgspec.json.decode(msgspec.json.encode(p), type=Point) == p
+        assert msgspec.msgpack.decode(msgspec.msgpack.encode(p), type=Point) == p
+        assert msgspec.convert({"x": 2}, Point) == Point(2)
+        dt = msgspec.json.decode(b'"2021-01-01T00:00:00+01:00"', type=datetime.datetime)
+        assert dt.utcoffset() == datetime.timedelta(hours=1)
+        """
+    )
+    script = textwrap.dedent(
+        f"""
+        import _interpreters
+
+        for _ in range(2):
+            interp = _interpreters.create("isolated")
+            assert _interpreters.exec(interp, {code!r}) is None
+            _interpreters.destroy(interp)
+
+        import msgspec
+        assert msgspec.json.encode([1]) == b"[1]"
+        """
+    )
+    subprocess.check_call([sys.executable, "-c", script])
+
+
+def test_reimported_module_errors():
+    """Errors are raised using the exception types of the module instance that
+    created the decoder, even after `msgspec._core` is imported again"""
+    script = textwrap.dedent(
+        """
+        import importlib
+        import sys
+
+        old = importlib.import_module("msgspec._core")
+        del sys.modules["msgspec._core"]
+        new = importlib.import_module("msgspec._core")
+        assert new.DecodeError is not old.DecodeError
+
+        def check(mod, decode, msg, exc_type):
+            try:
+                decode(msg)
+            except exc_type:
+                return
+            raise AssertionError(f"{exc_type} not raised")
+
+        for mod in [old, new]:
+            check(mod, mod.MsgpackDecoder(int).decode, b"\\xcd\\x01", mod.DecodeError)
+            check(mod, mod.MsgpackDecoder(int).decode, b"\\xa1a", mod.ValidationError)
+            check(mod, mod.JSONDecoder(int).decode, b"[1", mod.DecodeError)
+            check(mod, mod.JSONDecoder(int).decode, b'"a"', mod.ValidationError)
+        """
+    )
+    subprocess.check_call([sys.executable, "-c", script])
+
+
+def test_encoder_decoder_stats(proto):
+    enc = proto.Encoder()
+    dec = proto.Decoder(list[int])
+    try:
+        enc.stats()
+    except RuntimeError:
+        # Built without MSGSPEC_STATS
+        with pytest.raises(RuntimeError):
+            dec.stats()
+        return
+
+    msg = enc.encode([1, 2, 3])
+    assert dec.decode(msg) == [1, 2, 3]
+    with pytest.raises(msgspec.ValidationError):
+        dec.decode(enc.encode(["bad"]))
+
+    enc_stats = enc.stats()
+    assert enc_stats["calls"] == 2
+    assert enc_stats["bytes"] > len(msg)
+
+    dec_stats = dec.stats()
+    assert dec_stats["calls"] == 2
+    assert dec_stats["objects"]["int"] == 3
+    assert dec_stats["validation_errors"] == 1
+
+
+def test_json_decoder_stats_float_fallbacks():
+    dec = msgspec.json.Decoder()
+    try:
+        dec.stats()
+    except RuntimeError:
+        pytest.skip("Built without MSGSPEC_STATS")
+
+    dec.decode(b"[1.5, 0.1, 4873108843191699.0, 5.892656838759087e-295]")
+    assert dec.stats()["float_fallbacks"] == 0
+
+    # Subnormals and long inputs with ambiguous truncation need the fallback
+    dec.decode(b"[4.9406564584124654e-324, 9007199254740993.00001]")
+    assert dec.stats()["float_fallbacks"] == 2
@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import array
 import base64
 import datetime
 import decimal
@@ -8,7 +9,9 @@ import gc
 import itertools
 import json
 import math
+import random
 import string
+import struct
 import sys
 import uuid
 from dataclasses import dataclass
@@ -322,6 +325,39 @@ class TestEncoderMisc:
         out2 = enc.encode([1, 2, 3])
         assert out1 == out2
 
+    def test_encode_varying_sizes(self):
+        enc = msgspec.json.Encoder()
+        # Output buffers are preallocated from the sizes of previous messages,
+        # check that both growing and shrinking messages are encoded correctly
+        for n in [0, 10, 100_000, 1, 0, 50_000, 2, 200_000, 3]:
+            msg = ["x" * n, list(range(n // 100))]
+            assert enc.encode(msg) == msgspec.json.encode(msg)
+
+    def test_encode_lines_varying_sizes(self):
+        enc = msgspec.json.Encoder()
+        for n, m in [(0, 0), (1, 100), (10_000, 10), (1, 1), (3, 10_000), (5, 0)]:
+            # The first item may be much smaller or larger than the rest
+            items = [list(range(n))] + [{"x": "y" * i} for i in range(m)]
+            sol = b"".join(msgspec.json.encode(i) + b"\n" for i in items)
+            assert enc.encode_lines(items) == sol
+
+    def test_encode_lines_large_first_line(self):
+        # The size extrapolated from a large first line is capped, rather than
+        # trying to allocate (len(first) * len(items)) bytes
+        enc = msgspec.json.Encoder()
+        items = ["x" * 2_000_000] + [1] * 200_000
+        res = enc.encode_lines(items)
+        assert len(res) == 2_000_003 + 2 * 200_000
+        assert res.startswith(b'"xxx')
+        assert res.endswith(b"\n1\n1\n")
+
+    def test_encode_lines_iterable_releases_items(self):
+        enc = msgspec.json.Encoder()
+        item = [1, 2, 3]
+        count = sys.getrefcount(item)
+        enc.encode_lines(iter([item, item]))
+        assert sys.getrefcount(item) == count
+
     @pytest.mark.parametrize("n", range(3))
     @pytest.mark.parametrize("iterable", [False, True])
     def test_encode_lines(self, n, iterable):
@@ -376,6 +412,150 @@ class TestEncoderMisc:
             enc.encode_lines(gen())
 
 
+class TestFloatPrecision:
+    @pytest.mark.parametrize("precision", [None, 0, 3, 17])
+    def test_float_precision_attribute(self, precision):
+        enc = msgspec.json.Encoder(float_precision=precision)
+        assert enc.float_precision == precision
+        assert msgspec.json.Encoder().float_precision is None
+
+    @pytest.mark.parametrize("precision", [-1, 18, 1.5, "2", True, 2**100])
+    def test_float_precision_invalid(self, precision):
+        with pytest.raises(
+            ValueError, match="`float_precision` must be None or an int"
+        ):
+            msgspec.json.Encoder(float_precision=precision)
+
+    def test_float_precision_unsupported_by_other_encoders(self):
+        with pytest.raises(TypeError):
+            msgspec.msgpack.Encoder(float_precision=2)
+        with pytest.raises(TypeError):
+            msgspec.cbor.Encoder(float_precision=2)
+
+    @pytest.mark.parametrize(
+        "x, precision, sol",
+        [
+            (1.23456, 3, b"1.235"),
+            (1.0, 3, b"1.0"),
+            (1.5, 0, b"2.0"),
+            (2.5, 0, b"2.0"),
+            (1.25, 1, b"1.2"),
+            (1.0005, 3, b"1.0"),
+            (0.0004, 3, b"0.0"),
+            (-0.0004, 3, b"-0.0"),
+            (-0.0006, 3, b"-0.001"),
+            (0.0, 2, b"0.0"),
+            (-0.0, 2, b"-0.0"),
+            (5e-324, 17, b"0.0"),
+            (123456789.123456, 3, b"123456789.123"),
+            (0.1, 17, b"0.10000000000000001"),
+            (1e20, 3, b"1e20"),
+            (123456.789, 15, b"123456.789"),
+            (float("nan"), 3, b"null"),
+            (float("inf"), 3, b"null"),
+        ],
+    )
+    def test_float_precision(self, x, precision, sol):
+        enc = msgspec.json.Encoder(float_precision=precision)
+        assert enc.encode(x) == sol
+
+    def test_float_precision_matches_round(self):
+        rand = random.Random(42)
+        for _ in range(20000):
+            precision = rand.randint(0, 17)
+            x = rand.uniform(-1, 1) * 10 ** rand.randint(-20, 20)
+            enc = msgspec.json.Encoder(float_precision=precision)
+            res = msgspec.json.decode(enc.encode(x))
+            sol = round(x, precision)
+            assert res == sol
+            assert math.copysign(1, res) == math.copysign(1, sol)
+
+    def test_float_precision_applies_everywhere(self):
+        class Point(msgspec.Struct):
+            x: float
+            y: float
+
+        enc = msgspec.json.Encoder(float_precision=2)
+        assert enc.encode(Point(1.2345, 2.3456)) == b'{"x":1.23,"y":2.35}'
+        assert enc.encode(array.array("d", [1.2345])) == b"[1.23]"
+        assert enc.encode_columns({"x": array.array("f", [0.5])}) == b'[{"x":0.5}]'
+        assert enc.encode_lines([1.2345, 2.3456]) == b"1.23\n2.35\n"
+        # Dict keys keep their full precision
+        assert enc.encode({1.2345: 1.2345}) == b'{"1.2345":1.23}'
+
+
+class TestEncodeColumns:
+    def test_encode_columns_layout(self):
+        enc = msgspec.json.Encoder()
+        cols = {"x": array.array("q", [1, 2]), "y": ["a", "b"]}
+        records = b'[{"x":1,"y":"a"},{"x":2,"y":"b"}]'
+        lines = b'{"x":1,"y":"a"}\n{"x":2,"y":"b"}\n'
+        assert enc.encode_columns(cols) == records
+        assert enc.encode_columns(cols, layout="records") == records
+        assert enc.encode_columns(cols, layout="lines") == lines
+        assert enc.encode_columns({}, layout="lines") == b""
+
+    def test_encode_columns_escapes_keys(self):
+        enc = msgspec.json.Encoder()
+        assert enc.encode_columns({'a"b': [1]}) == b'[{"a\\"b":1}]'
+
+    def test_encode_columns_nonfinite(self):
+        enc = msgspec.json.Encoder()
+        cols = {"x": array.array("d", [float("nan"), float("inf")])}
+        assert enc.encode_columns(cols) == b'[{"x":null},{"x":null}]'
+
+    def test_encode_columns_bad_layout(self):
+        enc = msgspec.json.Encoder()
+        with pytest.raises(ValueError, match="`layout` must be one of"):
+            enc.encode_columns({}, layout="bad")
+        with pytest.raises(TypeError, match="Extra keyword arguments"):
+            enc.encode_columns({}, bad=1)
+
+
+class TestVector:
+    @pytest.mark.parametrize(
+        "msg",
+        [
+            b"[-9223372036854775809]",
+            b"[18446744073709551616]",
+            b"[123456789012345678901234567890]",
+        ],
+    )
+    def test_vector_int_out_of_range(self, msg):
+        with pytest.raises(msgspec.ValidationError, match="Integer value out of range"):
+            msgspec.json.decode(msg, type=msgspec.Vector[int])
+
+    def test_vector_float_matches_float(self):
+        values = [
+            "0.1",
+            "-1.7976931348623157e308",
+            "5e-324",
+            "123456789012345678901234567890",
+            "0.30000000000000004",
+            "1.00000000000000011102230246251565404236316680908203125",
+        ]
+        msg = ("[ " + " ,\n".join(values) + " ]").encode()
+        res = msgspec.json.decode(msg, type=msgspec.Vector[float])
+        assert list(res) == [float(v) for v in values]
+
+    @pytest.mark.parametrize(
+        "msg, error",
+        [
+            (b"[1,]", "trailing comma in array"),
+            (b"[1 2]", "expected ',' or ']'"),
+            (b"[-]", "invalid character"),
+            (b"[1.]", "invalid number"),
+        ],
+    )
+    def test_vector_malformed(self, msg, error):
+        with pytest.raises(msgspec.DecodeError, match=error):
+            msgspec.json.decode(msg, type=msgspec.Vector[float])
+
+    def test_vector_truncated(self):
+        with pytest.raises(msgspec.DecodeError, match="truncated"):
+            msgspec.json.decode(b"[1, 2", type=msgspec.Vector[int])
+
+
 class TestDecodeFunction:
     def test_decode(self):
         assert msgspec.json.decode(b"[1, 2, 3]") == [1, 2, 3]
@@ -541,6 +721,101 @@ class TestDecoderMisc:
             dec = msgspec.json.Decoder(float_hook=1)
 
 
+class TestDecodeFile:
+    def test_decode_file(self, tmp_path):
+        path = tmp_path / "test.json"
+        path.write_bytes(b'{"x": [1, 2, 3]}')
+        assert msgspec.json.decode_file(path) == {"x": [1, 2, 3]}
+        assert msgspec.json.decode_file(str(path)) == {"x": [1, 2, 3]}
+
+    def test_decode_file_typed(self, tmp_path):
+        class Ex(msgspec.Struct):
+            x: int
+
+        path = tmp_path / "test.json"
+        path.write_bytes(b'{"x": "1"}')
+        assert msgspec.json.decode_file(path, type=Ex, strict=False) == Ex(1)
+
+        with pytest.raises(msgspec.ValidationError, match="Expected `int`"):
+            msgspec.json.decode_file(path, type=Ex)
+
+    def test_decode_file_dec_hook(self, tmp_path):
+        path = tmp_path / "test.json"
+        path.write_bytes(b'"1.5"')
+        res = msgspec.json.decode_file(
+            path, type=decimal.Decimal, dec_hook=lambda t, o: t(o)
+        )
+        assert res == decimal.Decimal("1.5")
+
+    def test_decode_file_empty(self, tmp_path):
+        path = tmp_path / "test.json"
+        path.write_bytes(b"")
+        with pytest.raises(msgspec.DecodeError, match="truncated"):
+            msgspec.json.decode_file(path)
+
+    def test_decode_file_raw_outlives_map(self, tmp_path):
+        path = tmp_path / "test.json"
+        path.write_bytes(b'{"x": [1, 2]}')
+        res = msgspec.json.decode_file(path, type=Dict[str, msgspec.Raw])
+        assert bytes(res["x"]) == b"[1, 2]"
+
+    def test_decode_file_missing(self, tmp_path):
+        with pytest.raises(FileNotFoundError):
+            msgspec.json.decode_file(tmp_path / "missing.json")
+
+    @pytest.mark.parametrize(
+        "msg",
+        ["", "\n", "1", "  1", "1\t\r\n", "1\n\r\t 2", "1\n2\n", "1\n\n \n2\n3"],
+    )
+    def test_iter_lines_file(self, tmp_path, msg):
+        path = tmp_path / "test.ndjson"
+        path.write_bytes(msg.encode())
+        sol = msgspec.json.Decoder().decode_lines(msg)
+        assert list(msgspec.json.iter_lines_file(path)) == sol
+
+    def test_iter_lines_file_chunks(self, tmp_path, monkeypatch):
+        monkeypatch.setattr(msgspec.json, "_LINES_CHUNK_SIZE", 16)
+        sol = [{"x": i, "y": "a" * (i % 40)} for i in range(200)]
+        path = tmp_path / "test.ndjson"
+        path.write_bytes(msgspec.json.Encoder().encode_lines(sol))
+        assert list(msgspec.json.iter_lines_file(path)) == sol
+
+    def test_iter_lines_file_typed(self, tmp_path):
+        class Ex(msgspec.Struct):
+            x: int
+
+        path = tmp_path / "test.ndjson"
+        path.write_bytes(b'{"x": 1}\n{"x": 2.5}\n{"x": 3}')
+        it = msgspec.json.iter_lines_file(path, type=Ex)
+        assert next(it) == Ex(1)
+        with pytest.raises(msgspec.ValidationError, match="Expected `int`"):
+            next(it)
+
+        res = list(
+            msgspec.json.iter_lines_file(
+                path, type=Dict[str, decimal.Decimal], float_hook=decimal.Decimal
+            )
+        )
+        assert res[1] == {"x": decimal.Decimal("2.5")}
+
+    def test_iter_lines_file_close_early(self, tmp_path):
+        path = tmp_path / "test.ndjson"
+        path.write_bytes(b"1\n2\n3\n")
+        it = msgspec.json.iter_lines_file(path)
+        assert next(it) == 1
+        it.close()
+
+    def test_line_spans(self):
+        from msgspec._core import _json_line_spans
+
+        buf = b"1\n  \n 22\r\n333"
+        assert _json_line_spans(buf, 0, len(buf)) == ([0, 1, 6, 9, 10, 13], 13)
+        # Lines starting before `stop` are scanned to their end
+        assert _json_line_spans(buf, 0, 6) == ([0, 1, 6, 9], 10)
+        assert _json_line_spans(buf, 10, 100) == ([10, 13], 13)
+        assert _json_line_spans("1\n2", 0, 3) == ([0, 1, 2, 3], 3)
+
+
 class TestBoolAndNone:
     def test_encode_none(self):
         assert msgspec.json.encode(None) == b"null"
@@ -1288,6 +1563,20 @@ class TestFloat:
         x2 = msgspec.json.decode(s)
         assert x == x2
 
+    def test_encode_float_shortest_digits(self):
+        def digits(s):
+            mantissa = s.split("e")[0].lstrip("-").replace(".", "")
+            return mantissa.strip("0")
+
+        rand = random.Random(42)
+        for _ in range(20000):
+            x = struct.unpack("d", struct.pack("Q", rand.getrandbits(64)))[0]
+            if not math.isfinite(x) or x == 0:
+                continue
+            s = msgspec.json.encode(x).decode()
+            assert float(s) == x
+            assert digits(s) == digits(repr(x))
+
     @pytest.mark.parametrize("x", [-0.0, 0.0])
     def test_roundtrip_signed_zero(self, x):
         s = msgspec.json.encode(x)
@@ -1385,6 +1674,58 @@ class TestFloat:
         x = msgspec.json.decode(s)
         assert x == float(s)
 
+    @pytest.mark.parametrize("n_int", [1, 7, 8, 9, 16, 17, 19])
+    @pytest.mark.parametrize("n_frac", [0, 1, 7, 8, 9, 16, 17])
+    def test_decode_number_digit_run_lengths(self, n_int, n_frac):
+        """Digits are parsed 8 at a time, check runs ending around chunk
+        boundaries, both mid-buffer and at the end of the input"""
+        digits = "9876543210" * 4
+        s = digits[:n_int]
+        if n_frac:
+            s += "." + digits[n_int : n_int + n_frac]
+        for msg in [s, f"[{s}]", f"[{s},-{s}]", f'{{"a":{s}}}', s + " " * 8]:
+            assert msgspec.json.decode(msg.encode()) == json.loads(msg)
+        res = msgspec.json.decode(f"[{s},-{s}]".encode(), type=msgspec.Vector[float])
+        assert list(res) == [float(s), -float(s)]
+
+    @pytest.mark.parametrize("n", [0, 10, 30, 100])
+    @pytest.mark.parametrize(
+        "prefix", ["1.5", "0.0001", "123456789012345678.9", "12345678901234567890.0"]
+    )
+    @pytest.mark.parametrize("suffix", ["", "e5", "e-300"])
+    def test_decode_float_many_trailing_zeros(self, prefix, n, suffix):
+        s = prefix + "0" * n + suffix
+        for msg in [s, "-" + s]:
+            x = msgspec.json.decode(msg.encode())
+            assert type(x) is float
+            assert struct.pack("<d", x) == struct.pack("<d", float(msg))
+
+    @pytest.mark.parametrize(
+        "s",
+        [
+            # Exactly representable values and ties that Eisel-Lemire can't
+            # resolve on its own
+            "4873108843191699.0",
+            "549282900743149.25",
+            "9007199254740993.0",
+            "9007199254740995.0",
+            "9007199254740993e0",
+            "18014398509481987.5e-1",
+            "1844674407370955161.5e-27",
+            # Exponents outside the original Eisel-Lemire table
+            "5.892656838759087e-295",
+            "1.5815775434466972e-298",
+            "2.2250738585072014e-308",
+            "2.2250738585072011e-308",
+            "1.7976931348623157e308",
+            "17976931348623157e292",
+        ],
+    )
+    def test_decode_float_hard_cases(self, s):
+        for msg in [s, "-" + s]:
+            x = msgspec.json.decode(msg.encode())
+            assert struct.pack("<d", x) == struct.pack("<d", float(msg))
+
     @pytest.mark.parametrize("s", [b"123e308", b"-123e308", b"123e50000", b"123e50000"])
     def test_decode_float_boundaries_errors(self, s):
         with pytest.raises(msgspec.ValidationError, match="Number out of range"):
@@ -1,6 +1,8 @@
 from __future__ import annotations
 
+import array
 import datetime
+import decimal
 import enum
 import gc
 import itertools
@@ -9,6 +11,7 @@ import pickle
 import struct
 import sys
 from typing import (
+    Annotated,
     Any,
     Dict,
     FrozenSet,
@@ -269,6 +272,43 @@ class TestDecodeFunction:
             msgspec.msgpack.decode(msg)
 
 
+class TestDecodeFile:
+    def test_decode_file(self, tmp_path):
+        path = tmp_path / "test.msgpack"
+        path.write_bytes(msgspec.msgpack.encode({"x": [1, 2, 3]}))
+        assert msgspec.msgpack.decode_file(path) == {"x": [1, 2, 3]}
+        assert msgspec.msgpack.decode_file(str(path)) == {"x": [1, 2, 3]}
+
+    def test_decode_file_typed(self, tmp_path):
+        class Ex(msgspec.Struct):
+            x: int
+
+        path = tmp_path / "test.msgpack"
+        path.write_bytes(msgspec.msgpack.encode({"x": "1"}))
+        assert msgspec.msgpack.decode_file(path, type=Ex, strict=False) == Ex(1)
+
+        with pytest.raises(msgspec.ValidationError, match="Expected `int`"):
+            msgspec.msgpack.decode_file(path, type=Ex)
+
+    def test_decode_file_ext_hook(self, tmp_path):
+        path = tmp_path / "test.msgpack"
+        path.write_bytes(msgspec.msgpack.encode(msgspec.msgpack.Ext(1, b"abc")))
+        res = msgspec.msgpack.decode_file(path, ext_hook=lambda c, d: (c, bytes(d)))
+        assert res == (1, b"abc")
+
+    def test_decode_file_memoryview_outlives_map(self, tmp_path):
+        path = tmp_path / "test.msgpack"
+        path.write_bytes(msgspec.msgpack.encode(b"abc"))
+        res = msgspec.msgpack.decode_file(path, type=memoryview)
+        assert bytes(res) == b"abc"
+
+    def test_decode_file_empty(self, tmp_path):
+        path = tmp_path / "test.msgpack"
+        path.write_bytes(b"")
+        with pytest.raises(msgspec.DecodeError, match="truncated"):
+            msgspec.msgpack.decode_file(path)
+
+
 class TestEncoderMisc:
     def test_encoder_init_errors(self):
         with pytest.raises(TypeError):
@@ -277,6 +317,90 @@ class TestEncoderMisc:
         with pytest.raises(TypeError, match="enc_hook must be callable"):
             msgspec.msgpack.Encoder(enc_hook=1)
 
+    @pytest.mark.parametrize("float_format", ["float64", "float32", "smallest"])
+    def test_float_format_attribute(self, float_format):
+        enc = msgspec.msgpack.Encoder(float_format=float_format)
+        assert enc.float_format == float_format
+        assert msgspec.msgpack.Encoder().float_format == "float64"
+
+    @pytest.mark.parametrize("float_format", ["bad", 1, "FLOAT32"])
+    def test_float_format_invalid(self, float_format):
+        with pytest.raises(ValueError, match="`float_format` must be"):
+            msgspec.msgpack.Encoder(float_format=float_format)
+
+    def test_float_format_float32(self):
+        enc = msgspec.msgpack.Encoder(float_format="float32")
+        assert enc.encode(1.5) == b"\xca?\xc0\x00\x00"
+        assert enc.encode(1.0) == b"\xca?\x80\x00\x00"
+        # Lossy, values are rounded to the nearest float32
+        res = msgspec.msgpack.decode(enc.encode(0.1))
+        assert res != 0.1
+        assert res == struct.unpack("f", struct.pack("f", 0.1))[0]
+        assert msgspec.msgpack.decode(enc.encode(1e300)) == float("inf")
+
+    @pytest.mark.parametrize(
+        "x, sol",
+        [
+            (0.0, b"\x00"),
+            (1.0, b"\x01"),
+            (-1.0, b"\xff"),
+            (300.0, b"\xcd\x01\x2c"),
+            (-(2.0**63), b"\xd3\x80\x00\x00\x00\x00\x00\x00\x00"),
+            (-0.0, b"\xca\x80\x00\x00\x00"),
+            (1.5, b"\xca?\xc0\x00\x00"),
+            (2.0**63, b"\xca_\x00\x00\x00"),
+            (float("inf"), b"\xca\x7f\x80\x00\x00"),
+            (0.1, b"\xcb?\xb9\x99\x99\x99\x99\x99\x9a"),
+            (1e300, b"\xcb~7\xe4<\x88\x00u\x9c"),
+        ],
+    )
+    def test_float_format_smallest(self, x, sol):
+        enc = msgspec.msgpack.Encoder(float_format="smallest")
+        msg = enc.encode(x)
+        assert msg == sol
+        res = msgspec.msgpack.decode(msg, type=float)
+        assert res == x
+        assert math.copysign(1, res) == math.copysign(1, x)
+
+    def test_float_format_smallest_nan(self):
+        enc = msgspec.msgpack.Encoder(float_format="smallest")
+        msg = enc.encode(float("nan"))
+        assert msg[:1] == b"\xca"
+        assert math.isnan(msgspec.msgpack.decode(msg))
+
+    @pytest.mark.parametrize("float_format", ["float32", "smallest"])
+    def test_float_format_applies_everywhere(self, float_format):
+        enc = msgspec.msgpack.Encoder(float_format=float_format)
+
+        class Point(msgspec.Struct, array_like=True):
+            x: float
+            y: float
+
+        assert enc.encode(Point(1.5, 2.5)) == enc.encode([1.5, 2.5])
+        assert enc.encode(array.array("f", [1.5, 2.5])) == enc.encode([1.5, 2.5])
+        assert enc.encode_columns({"x": array.array("d", [1.5])}) == enc.encode(
+            [{"x": 1.5}]
+        )
+        msg = enc.encode(Point(0.25, 1.5))
+        assert len(msg) == 11
+        assert msgspec.msgpack.decode(msg, type=Point) == Point(0.25, 1.5)
+
+    def test_float_format_smallest_float32_buffers(self):
+        # Values in float32 buffers always roundtrip as float32
+        enc = msgspec.msgpack.Encoder(float_format="smallest")
+        values = array.array("f", [0.1, 1.1, 1e-20])
+        msg = enc.encode(values)
+        assert len(msg) == 1 + 5 * 3
+        assert msgspec.msgpack.decode(msg) == values.tolist()
+
+    def test_float_format_decimal(self):
+        enc = msgspec.msgpack.Encoder(float_format="smallest")
+        d = decimal.Decimal("1.5")
+        assert enc.encode(d) == msgspec.msgpack.encode("1.5")
+
+        enc = msgspec.msgpack.Encoder(decimal_format="number", float_format="smallest")
+        assert enc.encode(d) == enc.encode(1.5) == b"\xca?\xc0\x00\x00"
+
     @pytest.mark.parametrize("x", [-(2**63) - 1, 2**64])
     def test_encode_integer_limits(self, x):
         enc = msgspec.msgpack.Encoder()
@@ -458,6 +582,14 @@ class TestEncoderMisc:
         out2 = enc.encode([1, 2, 3])
         assert out1 == out2
 
+    def test_encode_varying_sizes(self):
+        enc = msgspec.msgpack.Encoder()
+        # Output buffers are preallocated from the sizes of previous messages,
+        # check that both growing and shrinking messages are encoded correctly
+        for n in [0, 10, 100_000, 1, 0, 50_000, 2, 200_000, 3]:
+            msg = [b"x" * n, list(range(n // 100))]
+            assert enc.encode(msg) == msgspec.msgpack.encode(msg)
+
     @pytest.mark.parametrize(
         "dt, dt_str",
         [
@@ -1391,6 +1523,184 @@ class TestTimestampExt:
         assert res.microsecond == micros
 
 
+class TestTypedArrayExt:
+    @pytest.fixture
+    def enc(self):
+        return msgspec.msgpack.Encoder(typed_array_ext=5)
+
+    @pytest.fixture
+    def dec(self):
+        return msgspec.msgpack.Decoder(typed_array_ext=5)
+
+    @pytest.mark.parametrize("typed_array_ext", [None, 0, 5, 127])
+    def test_typed_array_ext_attribute(self, typed_array_ext):
+        enc = msgspec.msgpack.Encoder(typed_array_ext=typed_array_ext)
+        dec = msgspec.msgpack.Decoder(typed_array_ext=typed_array_ext)
+        assert enc.typed_array_ext == typed_array_ext
+        assert dec.typed_array_ext == typed_array_ext
+
+    @pytest.mark.parametrize("typed_array_ext", [-1, 128, 1.5, "a"])
+    def test_typed_array_ext_invalid(self, typed_array_ext):
+        with pytest.raises(ValueError, match="typed_array_ext"):
+            msgspec.msgpack.Encoder(typed_array_ext=typed_array_ext)
+        with pytest.raises(ValueError, match="typed_array_ext"):
+            msgspec.msgpack.Decoder(typed_array_ext=typed_array_ext)
+
+    def test_json_encoder_doesnt_support_typed_array_ext(self):
+        with pytest.raises(TypeError):
+            msgspec.json.Encoder(typed_array_ext=5)
+
+    def test_encode_layout(self, enc):
+        msg = enc.encode(array.array("h", [1, -2]))
+        assert msg == b"\xc7\x0a\x05h\x01\x02\x00\x00\x00\x01\x00\xfe\xff"
+
+    @pytest.mark.parametrize("typecode", ["b", "B", "h", "H", "i", "I", "l", "q", "Q"])
+    def test_roundtrip_array_int(self, enc, dec, typecode):
+        x = array.array(typecode, [0, 1, 2, 3, 100])
+        res = dec.decode(enc.encode(x))
+        assert isinstance(res, memoryview)
+        assert res.itemsize == x.itemsize
+        assert res.shape == (5,)
+        assert res.tolist() == x.tolist()
+
+    @pytest.mark.parametrize("typecode", ["f", "d"])
+    def test_roundtrip_array_float(self, enc, dec, typecode):
+        x = array.array(typecode, [1.5, -2.0, math.inf])
+        res = dec.decode(enc.encode(x))
+        assert res.format == typecode
+        assert res.tolist() == x.tolist()
+
+    def test_roundtrip_empty(self, enc, dec):
+        res = dec.decode(enc.encode(array.array("d")))
+        assert res.format == "d"
+        assert res.tolist() == []
+
+    def test_roundtrip_multidimensional(self, enc, dec):
+        x = memoryview(array.array("i", range(24))).cast("B").cast("i", [2, 3, 4])
+        res = dec.decode(enc.encode(x))
+        assert res.shape == (2, 3, 4)
+        assert res.tolist() == x.tolist()
+
+    def test_roundtrip_bool(self, enc, dec):
+        x = memoryview(b"\x00\x01\x01").cast("?")
+        res = dec.decode(enc.encode(x))
+        assert res.format == "?"
+        assert res.tolist() == [False, True, True]
+
+    def test_decode_is_zero_copy(self, enc, dec):
+        msg = bytearray(enc.encode(array.array("d", [1.0, 2.0])))
+        res = dec.decode(msg)
+        assert res.obj is msg
+
+    def test_nested(self, enc, dec):
+        x = {"a": array.array("d", [1.0]), "b": [array.array("q", [2])]}
+        res = dec.decode(enc.encode(x))
+        assert res["a"].tolist() == [1.0]
+        assert res["b"][0].tolist() == [2]
+
+    def test_byte_memoryview_encodes_as_bin(self, enc):
+        assert enc.encode(memoryview(b"abc")) == b"\xc4\x03abc"
+
+    def test_non_contiguous_errors(self, enc):
+        x = memoryview(array.array("d", [1.0, 2.0, 3.0]))[::2]
+        with pytest.raises(BufferError):
+            enc.encode(x)
+
+    def test_disabled_by_default(self):
+        x = array.array("d", [1.0, 2.0])
+        assert msgspec.msgpack.encode(x) == msgspec.msgpack.encode([1.0, 2.0])
+        msg = msgspec.msgpack.Encoder(typed_array_ext=5).encode(x)
+        res = msgspec.msgpack.decode(msg)
+        assert isinstance(res, msgspec.msgpack.Ext)
+        assert res.code == 5
+
+    def test_other_ext_codes_unaffected(self, dec):
+        msg = msgspec.msgpack.encode(msgspec.msgpack.Ext(6, b"test"))
+        assert dec.decode(msg) == msgspec.msgpack.Ext(6, b"test")
+
+    def test_decode_typed_as_ext(self, enc):
+        msg = enc.encode(array.array("B", [1, 2]))
+        dec = msgspec.msgpack.Decoder(msgspec.msgpack.Ext, typed_array_ext=5)
+        assert dec.decode(msg) == msgspec.msgpack.Ext(
+            5, b"B\x01\x02\x00\x00\x00\x01\x02"
+        )
+
+    def test_decode_typed_as_memoryview(self, enc):
+        msg = enc.encode(array.array("d", [1.0, 2.0]))
+        dec = msgspec.msgpack.Decoder(memoryview, typed_array_ext=5)
+        assert dec.decode(msg).tolist() == [1.0, 2.0]
+
+    @pytest.mark.parametrize(
+        "typecode, vec_type, sol",
+        [
+            ("q", msgspec.Vector[int], array.array("q", [1, -2, 3])),
+            ("b", msgspec.Vector[int], array.array("q", [1, -2, 3])),
+            ("d", msgspec.Vector[float], array.array("d", [1.0, -2.0, 3.0])),
+            ("f", msgspec.Vector[float], array.array("d", [1.0, -2.0, 3.0])),
+            ("i", msgspec.Vector[float], array.array("d", [1.0, -2.0, 3.0])),
+        ],
+    )
+    def test_decode_typed_as_vector(self, enc, typecode, vec_type, sol):
+        msg = enc.encode(array.array(typecode, [1, -2, 3]))
+        dec = msgspec.msgpack.Decoder(vec_type, typed_array_ext=5)
+        assert dec.decode(msg) == sol
+
+    def test_decode_typed_as_vector_errors(self, enc):
+        dec = msgspec.msgpack.Decoder(List[msgspec.Vector[int]], typed_array_ext=5)
+
+        msg = enc.encode([array.array("d", [1.5])])
+        with pytest.raises(
+            msgspec.ValidationError,
+            match=r"Expected `int`, got `float` - at `\$\[0\]\[0\]`",
+        ):
+            dec.decode(msg)
+
+        msg = enc.encode([array.array("Q", [2**63])])
+        with pytest.raises(msgspec.ValidationError, match="Integer value out of range"):
+            dec.decode(msg)
+
+        msg = enc.encode([memoryview(b"\x00\x01").cast("?")])
+        with pytest.raises(
+            msgspec.ValidationError, match="Expected `array`, got `bool array`"
+        ):
+            dec.decode(msg)
+
+        x = memoryview(array.array("q", range(4))).cast("B").cast("q", [2, 2])
+        with pytest.raises(
+            msgspec.ValidationError,
+            match=r"Expected a 1-dimensional typed array, got 2 dimensions - at `\$\[0\]`",
+        ):
+            dec.decode(enc.encode([x]))
+
+    def test_decode_typed_as_vector_constraints(self, enc):
+        dec = msgspec.msgpack.Decoder(
+            Annotated[msgspec.Vector[float], msgspec.Meta(max_length=2)],
+            typed_array_ext=5,
+        )
+        assert dec.decode(enc.encode(array.array("d", [1, 2]))) == array.array(
+            "d", [1, 2]
+        )
+        with pytest.raises(msgspec.ValidationError, match="length <= 2"):
+            dec.decode(enc.encode(array.array("d", [1, 2, 3])))
+
+    @pytest.mark.parametrize(
+        "payload",
+        [
+            b"",
+            b"d",
+            b"z\x01\x01\x00\x00\x00\x00",
+            b"d\x01\x01\x00",
+            b"d\x01\x02\x00\x00\x00\x00\x00\x00\x00\x00\x00\xf0?",
+            b"d\x02\xff\xff\xff\xff\xff\xff\xff\xff",
+            b"B\x41" + b"\x00" * 4,
+        ],
+    )
+    def test_decode_invalid(self, dec, payload):
+        msg = msgspec.msgpack.encode(msgspec.msgpack.Ext(5, payload))
+        with pytest.raises(msgspec.ValidationError, match="Invalid typed array"):
+            dec.decode(msg)
+
+
 class CommonTypeTestBase:
     """Test msgspec untyped encode/decode"""
 
@@ -0,0 +1,195 @@
+import gc
+import multiprocessing
+import uuid
+from typing import List
+
+import pytest
+
+import msgspec
+from msgspec.shm import RingBuffer
+
+
+class Point(msgspec.Struct):
+    x: int
+    y: int
+
+
+class Message(msgspec.Struct):
+    id: int
+    payload: memoryview
+
+
+@pytest.fixture
+def ring():
+    rb = RingBuffer(create=True, capacity=1024)
+    try:
+        yield rb
+    finally:
+        gc.collect()
+        rb.close()
+        rb.unlink()
+
+
+def test_create_and_attach(ring):
+    assert ring.capacity == 1024
+    assert isinstance(ring.name, str)
+    assert repr(ring) == f"RingBuffer({ring.name!r}, capacity=1024)"
+
+    with RingBuffer(ring.name) as other:
+        assert other.name == ring.name
+        assert other.capacity == 1024
+
+
+def test_capacity_rounded_up():
+    with RingBuffer(create=True, capacity=1001) as rb:
+        assert rb.capacity == 1008
+        rb.unlink()
+
+
+def test_create_requires_capacity():
+    with pytest.raises(ValueError, match="`capacity` must be > 0"):
+        RingBuffer(create=True)
+
+
+def test_attach_requires_name():
+    with pytest.raises(ValueError, match="`name` is required"):
+        RingBuffer()
+
+
+def test_attach_invalid_segment():
+    from multiprocessing import shared_memory
+
+    shm = shared_memory.SharedMemory(create=True, size=256)
+    try:
+        with pytest.raises(ValueError, match="is not a msgspec RingBuffer"):
+            RingBuffer(shm.name)
+    finally:
+        shm.close()
+        shm.unlink()
+
+
+def test_send_recv(ring):
+    with RingBuffer(ring.name, type=Point) as reader:
+        ring.send(Point(1, 2))
+        ring.send(Point(3, 4))
+        assert reader.recv() == Point(1, 2)
+        assert reader.recv() == Point(3, 4)
+
+
+def test_wraparound(ring):
+    with RingBuffer(ring.name, type=List[int]) as reader:
+        for i in range(500):
+            msg = list(range(i % 50))
+            ring.send(msg, timeout=1)
+            assert reader.recv(timeout=1) == msg
+
+
+def test_send_blocks_until_released(ring):
+    with RingBuffer(ring.name) as reader:
+        msg = b"x" * 400
+        ring.send(msg)
+        ring.send(msg)
+        assert reader.recv() == msg
+        with pytest.raises(TimeoutError):
+            # The first message hasn't been released yet
+            ring.send(msg, timeout=0.01)
+        reader.release()
+        ring.send(msg, timeout=1)
+
+
+def test_recv_timeout(ring):
+    with RingBuffer(ring.name) as reader:
+        with pytest.raises(TimeoutError):
+            reader.recv(timeout=0.01)
+
+
+def test_message_too_large(ring):
+    with pytest.raises(ValueError, match="too large"):
+        ring.send(b"x" * 600)
+
+
+def test_zero_copy_memoryview(ring):
+    with RingBuffer(ring.name, type=Message) as reader:
+        ring.send(Message(1, memoryview(b"abc")))
+        msg = reader.recv()
+        assert msg.id == 1
+        assert isinstance(msg.payload, memoryview)
+        assert bytes(msg.payload) == b"abc"
+        del msg
+
+
+def test_decode_error_releases_message(ring):
+    with RingBuffer(ring.name, type=Point) as reader:
+        ring.send({"x": "bad", "y": 1})
+        ring.send(Point(1, 2))
+        with pytest.raises(msgspec.ValidationError):
+            reader.recv()
+        assert reader.recv() == Point(1, 2)
+
+
+def test_enc_hook_and_dec_hook(ring):
+    def enc_hook(obj):
+        if isinstance(obj, uuid.UUID):
+            return obj.bytes
+        raise NotImplementedError
+
+    def dec_hook(type, obj):
+        return uuid.UUID(bytes=obj)
+
+    u = uuid.uuid4()
+    with RingBuffer(ring.name, enc_hook=enc_hook) as writer:
+        with RingBuffer(ring.name, type=List[uuid.UUID], dec_hook=dec_hook) as reader:
+            writer.send([u])
+            assert reader.recv() == [u]
+
+
+def test_close_idempotent(ring):
+    other = RingBuffer(ring.name)
+    other.close()
+    other.close()
+
+
+@pytest.mark.parametrize("type", [msgspec.Raw, Message])
+def test_close_with_live_view_can_be_retried(ring, type):
+    reader = RingBuffer(ring.name, type=type)
+    ring.send(Message(1, memoryview(b"abc")))
+    msg = reader.recv()
+    with pytest.raises(BufferError):
+        reader.close()
+    with pytest.raises(BufferError):
+        reader.close()
+    del msg
+    gc.collect()
+    reader.close()
+    reader.close()
+
+
+def test_not_picklable(ring):
+    import pickle
+
+    with pytest.raises(TypeError, match="can't be pickled"):
+        pickle.dumps(ring)
+
+
+def _reader_process(name, n, queue):
+    with RingBuffer(name, type=Point) as reader:
+        total = 0
+        for _ in range(n):
+            total += reader.recv(timeout=10).x
+        queue.put(total)
+
+
+def test_multiprocess():
+    n = 1000
+    ctx = multiprocessing.get_context("spawn")
+    queue = ctx.Queue()
+    with RingBuffer(create=True, capacity=256) as ring:
+        try:
+            proc = ctx.Process(target=_reader_process, args=(ring.name, n, queue))
+            proc.start()
+            for i in range(n):
+                ring.send(Point(i, 0), timeout=10)
+            assert queue.get(timeout=30) == sum(range(n))
+            proc.join(timeout=30)
+        finally:
+            ring.unlink()
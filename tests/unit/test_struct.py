@@ -14,7 +14,7 @@ import pytest
 
 import msgspec
 from msgspec import NODEFAULT, UNSET, Struct, defstruct, field
-from msgspec.structs import StructConfig
+from msgspec.structs import StructConfig, StructList
 
 from .utils import temp_module
 
@@ -1290,6 +1290,260 @@ def test_struct_pickle(kw_only):
         pickle.dumps(a)
 
 
+def test_struct_reduce_kw_only():
+    """kw_only structs are pickled by field name, so pickles still load if
+    fields are reordered or added between versions"""
+    from msgspec._utils import rebuild
+
+    func, (cls, values) = PointKWOnly(x=1, y=2).__reduce__()
+    assert func is rebuild
+    assert cls is PointKWOnly
+    assert values == {"x": 1, "y": 2}
+
+    class Reordered(Struct, kw_only=True):
+        z: int = 3
+        y: int
+        x: int
+
+    assert func(Reordered, values) == Reordered(x=1, y=2)
+
+
+def test_struct_reduce_ex_kw_only_by_name():
+    """Large kw_only structs don't use the positional msgpack format"""
+    from msgspec._utils import rebuild
+
+    obj = BlobKWOnly(name="test", data=bytes(2048))
+    assert obj.__reduce_ex__(5) == (
+        rebuild,
+        (BlobKWOnly, {"name": "test", "data": bytes(2048)}),
+    )
+    items = StructList([obj] * 1000)
+    assert msgspec.structs._pickle_list(items) is None
+    assert pickle.loads(pickle.dumps(items, protocol=5)) == items
+
+
+class Blob(Struct):
+    name: str
+    data: bytes
+    values: List[float] = []
+    extra: Any = None
+
+
+class BlobKWOnly(Struct, kw_only=True):
+    name: str
+    data: bytes
+
+
+class TaggedBlobs(Struct, tag=True, array_like=True):
+    blob: Blob
+    others: List[Blob] = []
+
+
+class ReduceOverride(Struct):
+    x: int
+
+    def __reduce__(self):
+        return (ReduceOverride, (self.x + 1,))
+
+
+class MyInt(int):
+    pass
+
+
+class MyStructList(StructList):
+    pass
+
+
+_PICKLE_LIST_MUTATED = []
+
+
+def _clear_pickle_list(typ):
+    """Used in a string annotation, to mutate a list while its struct type's
+    annotations are being resolved"""
+    _PICKLE_LIST_MUTATED.clear()
+    return typ
+
+
+class TestStructPickleBuffer:
+    def roundtrip(self, obj, out_of_band=False):
+        buffers = []
+        data = pickle.dumps(
+            obj,
+            protocol=5,
+            buffer_callback=buffers.append if out_of_band else None,
+        )
+        return pickle.loads(data, buffers=buffers), buffers
+
+    @pytest.mark.parametrize("out_of_band", [False, True])
+    def test_roundtrip(self, out_of_band):
+        obj = Blob("test", bytes(range(256)) * 8, [1.5, -0.0], {"a": [1, None, "b"]})
+        res, buffers = self.roundtrip(obj, out_of_band)
+        assert res == obj
+        assert len(buffers) == (1 if out_of_band else 0)
+
+    def test_roundtrip_nested(self):
+        blob = Blob("test", bytes(2048), [1.0] * 10)
+        obj = TaggedBlobs(blob, [Blob(str(i), b"") for i in range(2000)])
+        res, buffers = self.roundtrip(obj, out_of_band=True)
+        assert res == obj
+        assert len(buffers) == 1
+
+    def test_roundtrip_list(self):
+        obj = [Blob(str(i), bytes(2048)) for i in range(3)]
+        res, buffers = self.roundtrip(obj, out_of_band=True)
+        assert res == obj
+        assert len(buffers) == 3
+
+    def test_small_structs_use_reduce(self):
+        obj = Blob("test", b"data")
+        assert obj.__reduce_ex__(5) == obj.__reduce__()
+
+    @pytest.mark.parametrize("protocol", [2, 3, 4])
+    def test_older_protocols_use_reduce(self, protocol):
+        obj = Blob("test", bytes(2048))
+        assert obj.__reduce_ex__(protocol) == obj.__reduce__()
+
+    @pytest.mark.parametrize(
+        "extra",
+        [(1, 2), {1, 2}, MyInt(1), Point(1, 2), 2**65, -(2**64), {(1, 2): 3}],
+    )
+    def test_inexact_values_use_reduce(self, extra):
+        obj = Blob("test", bytes(2048), extra=extra)
+        assert obj.__reduce_ex__(5) == obj.__reduce__()
+        res, _ = self.roundtrip(obj, out_of_band=True)
+        assert res == obj
+        assert type(res.extra) is type(extra)
+
+    def test_mistyped_values_use_reduce(self):
+        obj = Blob("test", bytes(2048), [1, 2])
+        assert obj.__reduce_ex__(5) == obj.__reduce__()
+        res, _ = self.roundtrip(obj)
+        assert type(res.values[0]) is int
+
+    def test_cycles_use_reduce(self):
+        extra = []
+        extra.append(extra)
+        obj = Blob("test", bytes(2048), extra=extra)
+        assert obj.__reduce_ex__(5) == obj.__reduce__()
+        res, _ = self.roundtrip(obj)
+        assert res.extra[0] is res.extra
+
+    def test_reduce_override_respected(self):
+        obj = ReduceOverride(1)
+        assert obj.__reduce_ex__(5) == (ReduceOverride, (2,))
+        assert pickle.loads(pickle.dumps(obj, protocol=5)) == ReduceOverride(2)
+
+    def test_unset_field_errors(self):
+        obj = Blob("test", bytes(2048))
+        del obj.name
+        with pytest.raises(AttributeError, match="Struct field 'name' is unset"):
+            pickle.dumps(obj, protocol=5)
+
+    def test_rebuild_errors(self):
+        func, (cls, buf) = Blob("test", bytes(2048)).__reduce_ex__(5)
+        with pytest.raises(TypeError, match="must be a `msgspec.Struct` type"):
+            func(int, buf)
+        with pytest.raises(msgspec.DecodeError):
+            func(cls, bytes(buf)[:-1])
+
+
+class TestStructListPickle:
+    def roundtrip(self, obj, out_of_band=False, protocol=5):
+        buffers = []
+        data = pickle.dumps(
+            obj,
+            protocol=protocol,
+            buffer_callback=buffers.append if out_of_band else None,
+        )
+        return pickle.loads(data, buffers=buffers), buffers
+
+    @pytest.mark.parametrize("out_of_band", [False, True])
+    def test_roundtrip(self, out_of_band):
+        obj = StructList(Blob(str(i), b"x", [i / 3]) for i in range(1000))
+        res, buffers = self.roundtrip(obj, out_of_band)
+        assert type(res) is StructList
+        assert res == obj
+        assert len(buffers) == (1 if out_of_band else 0)
+
+    def test_roundtrip_subclass(self):
+        obj = MyStructList(Blob(str(i), b"x") for i in range(1000))
+        res, buffers = self.roundtrip(obj, out_of_band=True)
+        assert type(res) is MyStructList
+        assert res == obj
+        assert len(buffers) == 1
+
+    def test_is_list(self):
+        obj = StructList([Blob("a", b"b")])
+        assert isinstance(obj, list)
+        assert obj == [Blob("a", b"b")]
+
+    @pytest.mark.parametrize(
+        "items",
+        [
+            [],
+            [Blob("test", b"")],
+            [Blob(str(i), b"") for i in range(1000)] + [1],
+            [Blob(str(i), b"") for i in range(1000)] + [Point(1, 2)],
+            [Blob(str(i), b"", extra=(1, 2)) for i in range(1000)],
+            [ReduceOverride(i) for i in range(1000)],
+        ],
+    )
+    def test_unsupported_use_list_reduce(self, items):
+        obj = StructList(items)
+        assert msgspec.structs._pickle_list(obj) is None
+        res, buffers = self.roundtrip(obj, out_of_band=True)
+        assert type(res) is StructList
+        assert res == [pickle.loads(pickle.dumps(x)) for x in items]
+        assert not buffers
+
+    @pytest.mark.parametrize("protocol", [2, 3, 4])
+    def test_older_protocols(self, protocol):
+        obj = StructList(Blob(str(i), b"x") for i in range(1000))
+        res, _ = self.roundtrip(obj, protocol=protocol)
+        assert type(res) is StructList
+        assert res == obj
+
+    def test_shared_references_not_preserved(self):
+        blob = Blob("test", bytes(2048))
+        obj = StructList([blob, blob])
+        res, _ = self.roundtrip(obj)
+        assert res == obj
+        assert res[0] is not res[1]
+
+    def test_unset_field_errors(self):
+        obj = StructList(Blob(str(i), b"x") for i in range(1000))
+        del obj[-1].name
+        with pytest.raises(AttributeError, match="Struct field 'name' is unset"):
+            pickle.dumps(obj, protocol=5)
+
+    def test_list_mutated_while_resolving_annotations(self):
+        class Lazy(Struct):
+            x: "_clear_pickle_list(bytes)"
+
+        items = [Lazy(bytes(100)) for _ in range(1000)]
+        _PICKLE_LIST_MUTATED[:] = items
+        try:
+            cls, buf = msgspec.structs._pickle_list(_PICKLE_LIST_MUTATED)
+        finally:
+            _PICKLE_LIST_MUTATED.clear()
+        assert not _PICKLE_LIST_MUTATED
+        assert msgspec.structs._rebuild_msgpack_list(cls, buf) == items
+
+    def test_rebuild_errors(self):
+        obj = StructList(Blob(str(i), b"x") for i in range(1000))
+        cls, buf = msgspec.structs._pickle_list(obj)
+        rebuild = msgspec.structs._rebuild_msgpack_list
+        assert rebuild(cls, buf) == obj
+        with pytest.raises(TypeError, match="must be a `msgspec.Struct` type"):
+            rebuild(int, buf)
+        with pytest.raises(msgspec.DecodeError):
+            rebuild(cls, bytes(buf)[:-1])
+
+    def test_pickle_list_errors(self):
+        with pytest.raises(TypeError, match="must be a list"):
+            msgspec.structs._pickle_list(())
+
+
 def test_struct_handles_missing_attributes():
     """If an attribute is unset, raise an AttributeError appropriately"""
 
@@ -1509,6 +1763,235 @@ def test_cache_hash_option():
             pass
 
 
+@pytest.mark.skipif(sys.maxsize > 2**32, reason="64 bit platform")
+def test_unboxed_unsupported_on_32_bit():
+    with pytest.raises(ValueError, match="only supported on 64 bit platforms"):
+
+        class Test(Struct, unboxed=True):
+            x: int
+
+
+@pytest.mark.skipif(sys.maxsize < 2**32, reason="Unboxed fields need 64 bit")
+class TestUnboxed:
+    def test_unboxed_option(self):
+        class Default(Struct):
+            x: int
+
+        assert not Default.__struct_config__.unboxed
+        assert "__msgspec_unboxed_mask__" not in Default.__slots__
+
+        class Enabled(Struct, unboxed=True):
+            x: int
+
+        assert Enabled.__struct_config__.unboxed
+        assert "__msgspec_unboxed_mask__" in Enabled.__slots__
+
+        class NoUnboxedFields(Struct, unboxed=True):
+            x: str
+
+        assert NoUnboxedFields.__struct_config__.unboxed
+        assert "__msgspec_unboxed_mask__" not in NoUnboxedFields.__slots__
+
+    def test_unboxed_mask_field_name_forbidden(self):
+        with pytest.raises(TypeError, match="Cannot have a struct field named"):
+
+            class Test(Struct):
+                __msgspec_unboxed_mask__: int
+
+    @pytest.mark.parametrize("ann", [int, "int"])
+    def test_unboxed_annotations(self, ann):
+        Test = defstruct("Test", [("x", ann), ("y", Optional[int])], unboxed=True)
+        t = Test(1, 2)
+        assert t.x == 1 and type(t.x) is int
+        # Only bare int/float/bool fields are unboxed
+        t.y = "not-validated"
+        assert t.y == "not-validated"
+        with pytest.raises(TypeError):
+            t.x = "bad"
+        assert t.x == 1
+
+    def test_unboxed_failed_set_keeps_old_value(self):
+        class Test(Struct, unboxed=True):
+            a: int
+            b: float
+            c: bool
+
+        t = Test(1, 2.5, True)
+        for name, value in [
+            ("a", "bad"),
+            ("a", 2**70),
+            ("a", True),
+            ("b", "bad"),
+            ("b", 2**2000),
+            ("c", 1),
+        ]:
+            with pytest.raises((TypeError, ValueError, OverflowError)):
+                setattr(t, name, value)
+        # Also when bypassing the struct's __setattr__
+        with pytest.raises(TypeError):
+            Test.a.__set__(t, "bad")
+        assert (t.a, t.b, t.c) == (1, 2.5, True)
+
+    def test_unboxed_values(self):
+        class Test(Struct, unboxed=True):
+            a: int
+            b: float
+            c: bool
+
+        t = Test(-(2**63), 1, True)
+        assert t.a == -(2**63)
+        assert type(t.b) is float and t.b == 1.0
+        assert t.c is True
+
+        t.a = 2**63 - 1
+        t.b = 2.5
+        t.c = False
+        assert (t.a, t.b, t.c) == (2**63 - 1, 2.5, False)
+
+        with pytest.raises(TypeError, match="can't delete"):
+            del t.a
+
+    @pytest.mark.parametrize(
+        "args, msg",
+        [
+            (("a", 1.0, True), "Expected `int` for unboxed field 'a', got `str`"),
+            ((True, 1.0, True), "Expected `int` for unboxed field 'a', got `bool`"),
+            ((1, "b", True), "Expected `float` for unboxed field 'b', got `str`"),
+            ((1, 1.0, 1), "Expected `bool` for unboxed field 'c', got `int`"),
+        ],
+    )
+    def test_unboxed_wrong_type(self, args, msg):
+        class Test(Struct, unboxed=True):
+            a: int
+            b: float
+            c: bool
+
+        with pytest.raises(TypeError, match=msg):
+            Test(*args)
+
+        with pytest.raises(TypeError, match=msg):
+            Test(**dict(zip("abc", args)))
+
+    def test_unboxed_int_out_of_range(self):
+        class Test(Struct, unboxed=True):
+            a: int
+
+        with pytest.raises(ValueError, match="only supports integers"):
+            Test(2**63)
+
+    def test_unboxed_defaults(self):
+        class Test(Struct, unboxed=True):
+            a: int = 1
+            b: float = 2
+            c: bool = True
+            d: int = field(default_factory=lambda: 3)
+
+        t = Test()
+        assert (t.a, t.b, t.c, t.d) == (1, 2.0, True, 3)
+        assert type(t.b) is float
+
+        with pytest.raises(TypeError, match="unboxed field 'a'"):
+
+            class Invalid(Struct, unboxed=True):
+                a: int = "bad"
+
+    def test_unboxed_missing_required(self):
+        class Test(Struct, unboxed=True):
+            a: int
+            b: float = 1.0
+
+        with pytest.raises(TypeError, match="Missing required argument 'a'"):
+            Test(b=2.0)
+
+    def test_unboxed_methods(self):
+        class Test(Struct, unboxed=True, order=True):
+            a: int
+            b: float
+            c: bool = False
+            d: str = ""
+
+        t = Test(1, 2.5, True, "x")
+        assert repr(t) == "Test(a=1, b=2.5, c=True, d='x')"
+        assert t == Test(1, 2.5, True, "x")
+        assert t != Test(1, 2.5, False, "x")
+        assert t < Test(1, 3.5, False, "x")
+        assert copy.copy(t) == t
+        assert t.__reduce__() == (Test, (1, 2.5, True, "x"))
+        assert msgspec.structs.replace(t, b=4.5) == Test(1, 4.5, True, "x")
+        assert msgspec.structs.asdict(t) == {"a": 1, "b": 2.5, "c": True, "d": "x"}
+        assert msgspec.structs.astuple(t) == (1, 2.5, True, "x")
+        assert list(t.__rich_repr__()) == [
+            ("a", 1),
+            ("b", 2.5),
+            ("c", True),
+            ("d", "x"),
+        ]
+
+    def test_unboxed_hash(self):
+        class Test(Struct, unboxed=True, frozen=True):
+            a: int
+            b: float
+
+        assert hash(Test(1, 2.5)) == hash(Test(1, 2.5))
+        assert hash(Test(1, 2.5)) != hash(Test(1, 3.5))
+
+    def test_unboxed_repr_omit_defaults(self):
+        class Test(Struct, unboxed=True, repr_omit_defaults=True):
+            a: int = 1000
+            b: float = 1.5
+            c: bool = False
+
+        assert repr(Test()) == "Test()"
+        assert repr(Test(1001, 1.5, True)) == "Test(a=1001, c=True)"
+
+    def test_unboxed_inheritance(self):
+        class Base(Struct, unboxed=True):
+            a: int
+            b: float
+
+        class Sub(Base):
+            c: int
+
+        class NotUnboxed(Base, unboxed=False):
+            d: int
+
+        assert Sub.__struct_config__.unboxed
+        assert not NotUnboxed.__struct_config__.unboxed
+        assert "__msgspec_unboxed_mask__" not in Sub.__slots__
+
+        s = Sub(1, 2.0, 3)
+        assert (s.a, s.b, s.c) == (1, 2.0, 3)
+        with pytest.raises(TypeError):
+            s.c = "bad"
+
+        # Inherited fields remain unboxed, new fields are boxed
+        n = NotUnboxed(1, 2.0, "not-validated")
+        assert n.d == "not-validated"
+        with pytest.raises(TypeError):
+            NotUnboxed("bad", 2.0, 3)
+
+        with pytest.raises(TypeError, match="Cannot change the type of unboxed field"):
+
+            class Invalid(Base):
+                a: str
+
+    def test_unboxed_max_index(self):
+        fields = [(f"x{i}", str) for i in range(64)] + [("y", int)]
+        with pytest.raises(ValueError, match="first 64 fields"):
+            defstruct("Test", fields, unboxed=True)
+
+        Test = defstruct("Test", fields[1:], unboxed=True)
+        assert Test(*range(64)).y == 63
+
+    def test_unboxed_gc(self):
+        class Test(Struct, unboxed=True):
+            a: int
+            b: Any
+
+        assert not gc.is_tracked(Test(1, 2))
+        assert gc.is_tracked(Test(1, []))
+
+
 def test_invalid_option_raises():
     with pytest.raises(TypeError):
 
@@ -1,3 +1,4 @@
+import array
 import base64
 import datetime
 import decimal
@@ -248,6 +249,17 @@ class TestToBuiltins:
         with pytest.raises(TypeError, match="Encoding objects of type Bad"):
             to_builtins(msg)
 
+    @pytest.mark.parametrize("typecode", ["q", "d"])
+    def test_array_array(self, typecode):
+        res = to_builtins(array.array(typecode, [1, 2]))
+        assert res == [1, 2]
+        assert type(res) is list
+
+    def test_array_array_unsupported_typecode_enc_hook(self):
+        typecode = "w" if sys.version_info >= (3, 13) else "u"
+        res = to_builtins(array.array(typecode, "ab"), enc_hook=lambda x: x.tounicode())
+        assert res == "ab"
+
     def test_namedtuple(self):
         class Point(NamedTuple):
             x: int
@@ -654,3 +666,19 @@ class TestOrder:
 
         res = to_builtins(Ex(0, 1), order="sorted")
         self.assert_eq(res, {"x": 1, "y": 2, "z": 0})
+
+    def test_order_dict_repeated_shapes(self):
+        shapes = [
+            ["b", "a", "c"],
+            ["a", "b", "c"],
+            ["b", "a", "d"],
+            ["é", "e", "💯", ""],
+            ["b", "a\ud800"],
+            ["b", "a", "x" * 100],
+            [3, 1, 2],
+        ]
+        for _ in range(3):
+            for keys in shapes:
+                msg = {k: i for i, k in enumerate(keys)}
+                res = to_builtins(msg, order="sorted")
+                self.assert_eq(res, dict(sorted(msg.items())))
@@ -1,10 +1,10 @@
 import dataclasses
 import datetime
 import enum
-import sys
+import math
 import uuid
 from decimal import Decimal
-from typing import Dict, FrozenSet, List, Set, Tuple
+from typing import Dict, FrozenSet, List, Set, Tuple, Union
 
 import pytest
 
@@ -24,12 +24,10 @@ except ImportError:
     tomli_w = None
 
 
-needs_decode = pytest.mark.skipif(
+needs_tomllib = pytest.mark.skipif(
     tomllib is None, reason="Neither tomllib or tomli are installed"
 )
-needs_encode = pytest.mark.skipif(tomli_w is None, reason="tomli_w is not installed")
-
-PY311 = sys.version_info[:2] >= (3, 11)
+needs_tomli_w = pytest.mark.skipif(tomli_w is None, reason="tomli_w is not installed")
 
 UTC = datetime.timezone.utc
 
@@ -59,21 +57,6 @@ def test_module_dir():
     assert set(dir(msgspec.toml)) == {"encode", "decode"}
 
 
-@pytest.mark.skipif(PY311, reason="tomllib is builtin in 3.11+")
-def test_tomli_not_installed_error(monkeypatch):
-    monkeypatch.setitem(sys.modules, "tomli", None)
-
-    with pytest.raises(ImportError, match="conda install"):
-        msgspec.toml.decode("a = 1", type=int)
-
-
-def test_tomli_w_not_installed_error(monkeypatch):
-    monkeypatch.setitem(sys.modules, "tomli_w", None)
-
-    with pytest.raises(ImportError, match="conda install"):
-        msgspec.toml.encode({"a": 1})
-
-
 @pytest.mark.parametrize(
     "val",
     [
@@ -90,8 +73,6 @@ def test_tomli_w_not_installed_error(monkeypatch):
         {"one": 2},
     ],
 )
-@needs_encode
-@needs_decode
 def test_roundtrip_any(val):
     msg = msgspec.toml.encode({"x": val})
     res = msgspec.toml.decode(msg)["x"]
@@ -126,21 +107,17 @@ def test_roundtrip_any(val):
         (ExDataclass(1, "two"), ExDataclass),
     ],
 )
-@needs_encode
-@needs_decode
 def test_roundtrip_typed(val, type):
     msg = msgspec.toml.encode({"x": val})
     res = msgspec.toml.decode(msg, type=Dict[str, type])["x"]
     assert res == val
 
 
-@needs_encode
 def test_encode_output_type():
     msg = msgspec.toml.encode({"x": 1})
     assert isinstance(msg, bytes)
 
 
-@needs_encode
 def test_encode_error():
     class Oops:
         pass
@@ -149,14 +126,12 @@ def test_encode_error():
         msgspec.toml.encode({"x": Oops()})
 
 
-@needs_encode
-@needs_decode
 def test_encode_enc_hook():
     msg = msgspec.toml.encode({"x": Decimal(1.5)}, enc_hook=str)
     assert msgspec.toml.decode(msg) == {"x": "1.5"}
 
 
-@needs_encode
+@needs_tomli_w
 @pytest.mark.parametrize("order", [None, "deterministic"])
 def test_encode_order(order):
     msg = {"y": 1, "x": ({"n": 1, "m": 2},), "z": [{"b": 1, "a": 2}]}
@@ -169,7 +144,6 @@ def test_encode_order(order):
     assert res == sol
 
 
-@needs_decode
 def test_decode_str_or_bytes_like():
     assert msgspec.toml.decode("a = 1") == {"a": 1}
     assert msgspec.toml.decode(b"a = 1") == {"a": 1}
@@ -179,20 +153,17 @@ def test_decode_str_or_bytes_like():
         msgspec.toml.decode(1)
 
 
-@needs_decode
 @pytest.mark.parametrize("msg", [b"{{", b"!!binary 123"])
 def test_decode_parse_error(msg):
     with pytest.raises(msgspec.DecodeError):
         msgspec.toml.decode(msg)
 
 
-@needs_decode
 def test_decode_validation_error():
     with pytest.raises(msgspec.ValidationError, match="Expected `str`"):
         msgspec.toml.decode(b"a = [1, 2, 3]", type=Dict[str, List[str]])
 
 
-@needs_decode
 @pytest.mark.parametrize("strict", [True, False])
 def test_decode_strict_or_lax(strict):
     msg = b"a = ['1', '2']"
@@ -206,7 +177,6 @@ def test_decode_strict_or_lax(strict):
         assert res == {"a": [1, 2]}
 
 
-@needs_decode
 def test_decode_dec_hook():
     def dec_hook(typ, val):
         if typ is Decimal:
@@ -215,3 +185,437 @@ def test_decode_dec_hook():
 
     res = msgspec.toml.decode("a = '1.5'", type=Dict[str, Decimal], dec_hook=dec_hook)
     assert res == {"a": Decimal("1.5")}
+
+
+TOML_DOCUMENTS = [
+    "",
+    "# just a comment\n",
+    "a = 1\nb = 'two'\n",
+    "a = 1\r\nb = 2\r\n",
+    "a.b.c = 1\na.b.d = 2\n",
+    "[a.b.c]\nx = 1\n[a]\ny = 2\n",
+    "[a]\nb = 1 # comment\n\n[c] # comment\nd = 2",
+    "[ a . 'b' . \"c\" ]\nx = 1\n",
+    '"quoted key" = 1\n\'literal key\' = 2\n"" = 3\n1234 = 4\na-b_c = 5\n',
+    'a."b.c".d = 1\n',
+    (
+        "[[fruits]]\nname = 'apple'\n[fruits.physical]\ncolor = 'red'\n"
+        "[[fruits.varieties]]\nname = 'red delicious'\n"
+        "[[fruits.varieties]]\nname = 'granny smith'\n"
+        "[[fruits]]\nname = 'banana'\n[[fruits.varieties]]\nname = 'plantain'\n"
+    ),
+    "a = {}\nb = {x = 1, y.z = [1, {c = 2}]}\n",
+    "a = []\nb = [\n  1, # comment\n  2,\n]\nc = [[1, 2], ['x', 3.0], [{}]]\n",
+    's = "tab\\there \\u00e9 \\U0001F600 \\"q\\" \\\\ \\b\\f\\n\\r"\n',
+    "s = 'no escapes \\n here'\n",
+    's = """\nline1\nline2 \\\n   continued"""\n',
+    's = """a""b""""\n',
+    "s = '''\nraw \\n'''\n",
+    "s = '''a''b'''''\n",
+    's = """x\r\ny"""\n',
+    "u = 'caf\u00e9'\n'\u00fc' = 1\n",
+    (
+        "i = [0, +1, -1, 1_000, 0xDEAD_beef, 0o17, 0b101, "
+        "9223372036854775808, -9223372036854775809, 99999999999999999999999]\n"
+    ),
+    "f = [1.0, -0.5, 1e10, 1E-5, 6.626e-34, 1_0.0_1, 0.0, -0.0, 1e+3, 3_14.15_9]\n",
+    "f = [inf, -inf, +inf]\n",
+    "b = [true, false]\n",
+    (
+        "d = [1979-05-27T07:32:00Z, 1979-05-27T00:32:00-07:00, "
+        "1979-05-27T00:32:00.999999+07:00, 1979-05-27 07:32:00Z, "
+        "1979-05-27t07:32:00, 1979-05-27, 07:32:00, 00:32:00.5]\n"
+    ),
+    "d = 1979-05-27 # a date, not a datetime\n",
+]
+
+
+@needs_tomllib
+@pytest.mark.parametrize("doc", TOML_DOCUMENTS)
+def test_decode_matches_tomllib(doc):
+    sol = tomllib.loads(doc)
+    assert msgspec.toml.decode(doc) == sol
+    assert msgspec.toml.decode(doc.encode("utf-8")) == sol
+
+
+def test_decode_nan():
+    res = msgspec.toml.decode("a = nan\nb = -nan\nc = +nan")
+    assert all(math.isnan(v) for v in res.values())
+
+
+@pytest.mark.parametrize(
+    "doc",
+    [
+        "a = 1\na = 2",
+        "a.b = 1\na.b.c = 2",
+        "a = 1\n[a.b]",
+        "[a]\n[a]",
+        "[a.b]\n[a]\n[a.b]",
+        "[a]\nb = 1\n[a.b.c]",
+        "[x]\na.b.c = 1\n[x.a]",
+        "[a]\nb.c = 1\n[a.b]\nd = 1",
+        "[x.a.b]\nc = 1\n[x]\na.b.d = 2",
+        "[[a]]\n[a]",
+        "a = [1]\n[[a]]",
+        "a = [{b = 1}]\n[[a]]",
+        "a = {b = 1}\n[a]",
+        "a = {b = 1}\na.c = 2",
+        "a = {b = {c = 1}, b.d = 2}",
+        "a = {b = 1, b = 2}",
+        "a = {b = 1,}",
+        "a = {\nb = 1}",
+        "a = {b = 1",
+        "a = [,]",
+        "a = [1 2]",
+        "a = 1 b = 2",
+        "a =",
+        "= 1",
+        "[table] x = 1",
+        "[a",
+        "[[a]",
+        "a = 1\rb = 2",
+        "a = 1\x00",
+        "a = 1 # \x01",
+        's = "\\ud800"',
+        's = "\\x41"',
+        's = "\x01"',
+        "s = 'no\nnewline'",
+        's = "unterminated',
+        's = """unterminated',
+        "i = 01",
+        "i = 1__0",
+        "i = _1",
+        "i = 1_",
+        "i = +0x1",
+        "i = 0x",
+        "f = 1.",
+        "f = .5",
+        "f = 1e",
+        "f = 01.5",
+        "b = True",
+        "b = truex",
+        "d = 1979-05-27T07:32Z",
+        "d = 1979-13-27",
+        "d = 1979-02-30",
+        "d = 25:00:00",
+        "d = 1979-05-27T07:32:00+0700",
+        "d = 1979-05-27 x",
+    ],
+)
+def test_decode_invalid(doc):
+    if tomllib is not None:
+        with pytest.raises(tomllib.TOMLDecodeError):
+            tomllib.loads(doc)
+    with pytest.raises(msgspec.DecodeError, match="TOML is malformed"):
+        msgspec.toml.decode(doc)
+
+
+def test_decode_invalid_error_location():
+    with pytest.raises(msgspec.DecodeError) as rec:
+        msgspec.toml.decode("a = 1\n[b]\nc = 2\nc = 3")
+    assert str(rec.value) == "TOML is malformed: duplicate key (line 4, column 1)"
+
+    with pytest.raises(msgspec.DecodeError) as rec:
+        msgspec.toml.decode("a = [1, 2\n  3]")
+    assert str(rec.value) == "TOML is malformed: expected ',' or ']' (line 2, column 3)"
+
+
+def test_decode_invalid_utf8():
+    with pytest.raises(UnicodeDecodeError):
+        msgspec.toml.decode(b"a = '\xff'")
+    with pytest.raises(UnicodeDecodeError):
+        msgspec.toml.decode(b"# \xff")
+
+
+def test_decode_datetimes():
+    res = msgspec.toml.decode(
+        "a = 1979-05-27T07:32:00.123456789-07:00\n"
+        "b = 1979-05-27 07:32:00\n"
+        "c = 1979-05-27\n"
+        "d = 07:32:00.5\n"
+    )
+    tz = datetime.timezone(datetime.timedelta(hours=-7))
+    # Sub-microsecond precision is truncated, as required by the TOML spec
+    assert res["a"] == datetime.datetime(1979, 5, 27, 7, 32, 0, 123456, tz)
+    assert res["b"] == datetime.datetime(1979, 5, 27, 7, 32)
+    assert res["c"] == datetime.date(1979, 5, 27)
+    assert res["d"] == datetime.time(7, 32, 0, 500000)
+
+
+@pytest.mark.parametrize(
+    "msg, sol",
+    [
+        (
+            "1979-12-31T23:59:59.9999995",
+            datetime.datetime(1979, 12, 31, 23, 59, 59, 999999),
+        ),
+        ("23:59:59.9999999", datetime.time(23, 59, 59, 999999)),
+        (
+            "9999-12-31T23:59:59.9999999",
+            datetime.datetime(9999, 12, 31, 23, 59, 59, 999999),
+        ),
+        (
+            "9999-12-31 23:59:59.999999999Z",
+            datetime.datetime(9999, 12, 31, 23, 59, 59, 999999, UTC),
+        ),
+    ],
+)
+def test_decode_datetimes_truncate_fractional_seconds(msg, sol):
+    assert msgspec.toml.decode(f"a = {msg}") == {"a": sol}
+
+
+class Physical(msgspec.Struct):
+    color: str
+    shape: str = "round"
+
+
+class Fruit(msgspec.Struct):
+    name: str
+    physical: Physical
+    varieties: List[str] = []
+
+
+class Basket(msgspec.Struct):
+    owner: str
+    updated: datetime.datetime
+    fruits: List[Fruit]
+
+
+def test_decode_typed_nested_tables():
+    doc = """
+    owner = "alice"
+    updated = 2022-01-02T03:04:05Z
+
+    [[fruits]]
+    name = "apple"
+    varieties = ["fuji", "gala"]
+
+    [fruits.physical]
+    color = "red"
+
+    [[fruits]]
+    name = "banana"
+    physical.color = "yellow"
+    physical.shape = "long"
+    """
+    res = msgspec.toml.decode(doc, type=Basket)
+    assert res == Basket(
+        owner="alice",
+        updated=datetime.datetime(2022, 1, 2, 3, 4, 5, tzinfo=UTC),
+        fruits=[
+            Fruit("apple", Physical("red"), ["fuji", "gala"]),
+            Fruit("banana", Physical("yellow", "long")),
+        ],
+    )
+
+
+def test_decode_typed_tag_after_fields():
+    class Cat(msgspec.Struct, tag=True):
+        name: str
+
+    class Dog(msgspec.Struct, tag=True):
+        name: str
+
+    # The tag may appear after other fields, or in a later section
+    res = msgspec.toml.decode(
+        "[pet]\nname = 'rex'\ntype = 'Dog'", type=Dict[str, Union[Cat, Dog]]
+    )
+    assert res == {"pet": Dog("rex")}
+
+
+def test_decode_typed_validation_error_path():
+    with pytest.raises(
+        msgspec.ValidationError,
+        match=r"Object missing required field `physical` - at `\$.fruits\[0\]`",
+    ):
+        msgspec.toml.decode("[[fruits]]\nname = 'x'", type=Basket)
+
+    with pytest.raises(
+        msgspec.ValidationError,
+        match=r"Expected `str`, got `int` - at `\$\[...\]\[1\]`",
+    ):
+        msgspec.toml.decode("a = ['x', 1]", type=Dict[str, List[str]])
+
+
+def test_decode_typed_datetime_strict():
+    msg = "a = 2022-01-02"
+    assert msgspec.toml.decode(msg, type=Dict[str, datetime.date]) == {
+        "a": datetime.date(2022, 1, 2)
+    }
+    with pytest.raises(msgspec.ValidationError, match="Expected `str`"):
+        msgspec.toml.decode(msg, type=Dict[str, str])
+
+
+def test_decode_dec_hook_not_callable():
+    with pytest.raises(TypeError, match="dec_hook must be callable"):
+        msgspec.toml.decode("a = 1", dec_hook=1)
+
+
+def test_decode_deeply_nested():
+    depth = 100000
+    with pytest.raises(RecursionError):
+        msgspec.toml.decode("a = " + "[" * depth + "]" * depth)
+
+
+TOML_ENCODE_DOCUMENTS = [
+    {},
+    {"a": 1, "b": "two", "c": True, "d": 1.5, "e": -0.0},
+    {"big": 2**64, "neg": -(2**70)},
+    {"empty": [], "arr": [1, [2, 3], []]},
+    {"keys": {"bare-key_1": 1, "": 2, "with space": 3, "é": 4, 'q"': 5, "a.b": 6}},
+    {"s": 'quote " backslash \\ tab \t newline \n cr \r ctrl \x01 \x7f \b \f'},
+    {"s": "unicode é 😀"},
+    {"a": {"b": {"c": 1}}},
+    {"a": {"b": {"c": 1}, "d": 2}},
+    {"a": {}, "b": {"c": {}}},
+    {"x": 1, "tbl": {"y": 2}, "z": 3},
+    {"inline": {"x": 1, "y": [1, 2]}},
+    {"aot": [{"a": 1}, {"b": 2}]},
+    {"aot": [{"a": "x" * 100}, {"b": 2}]},
+    {"aot": [{"a": "é" * 88}]},
+    {"aot": [{"a": "é" * 89}]},
+    {"aot": [{"a": [1]}]},
+    {"aot": [{"a": {"b": [{"c": "x" * 100, "d": {"e": 1}}]}}]},
+    {"arr": [{"a": 1}, 2]},
+    {"nested": [[{"a": 1}], [{"b": 2}]]},
+    {"f": [1e300, 1.5e-300, 1e-7, 1e-5, 1e-4, 1e15, 1e16, 123.0, 5e-324, -0.0]},
+    {"aot": [{"f": 1e-7, "s": "x" * 80}]},
+    {
+        "a": datetime.datetime(2022, 1, 2, 3, 4, 5, tzinfo=UTC),
+        "b": datetime.datetime(2022, 1, 2, 3, 4, 5, 6),
+        "c": datetime.datetime(
+            2022, 1, 2, 3, 4, 5, 600, datetime.timezone(-datetime.timedelta(hours=7))
+        ),
+        "d": datetime.time(3, 4, 5, 6),
+    },
+]
+
+
+@needs_tomli_w
+@pytest.mark.parametrize("msg", TOML_ENCODE_DOCUMENTS)
+def test_encode_matches_tomli_w(msg):
+    sol = tomli_w.dumps(msg).encode("utf-8")
+    assert msgspec.toml.encode(msg) == sol
+
+
+@pytest.mark.parametrize("msg", TOML_ENCODE_DOCUMENTS)
+def test_encode_roundtrips(msg):
+    sol = msgspec.to_builtins(
+        msg, builtin_types=(datetime.datetime, datetime.date, datetime.time)
+    )
+    assert msgspec.toml.decode(msgspec.toml.encode(msg)) == sol
+
+
+def test_encode_table_layout():
+    msg = {
+        "title": "example",
+        "owner": {"name": "alice", "dob": datetime.date(1979, 5, 27)},
+        "servers": [
+            {"name": "alpha", "ip": "10.0.0.1", "tags": ["a", "b"]},
+            {"name": "beta", "ip": "10.0.0.2", "tags": []},
+        ],
+        "points": [{"x": 1, "y": 2}, {"x": 3, "y": 4}],
+    }
+    sol = (
+        b'title = "example"\n'
+        b"points = [\n"
+        b"    { x = 1, y = 2 },\n"
+        b"    { x = 3, y = 4 },\n"
+        b"]\n"
+        b"\n"
+        b"[owner]\n"
+        b'name = "alice"\n'
+        b"dob = 1979-05-27\n"
+        b"\n"
+        b"[[servers]]\n"
+        b'name = "alpha"\n'
+        b'ip = "10.0.0.1"\n'
+        b"tags = [\n"
+        b'    "a",\n'
+        b'    "b",\n'
+        b"]\n"
+        b"\n"
+        b"[[servers]]\n"
+        b'name = "beta"\n'
+        b'ip = "10.0.0.2"\n'
+        b"tags = []\n"
+    )
+    assert msgspec.toml.encode(msg) == sol
+
+
+def test_encode_datetimes():
+    tz = datetime.timezone(datetime.timedelta(hours=-7))
+    msg = {
+        "a": datetime.datetime(1979, 5, 27, 7, 32, 0, 123456, UTC),
+        "b": datetime.datetime(1979, 5, 27, 7, 32, tzinfo=tz),
+        "c": datetime.datetime(1979, 5, 27, 7, 32),
+        "d": datetime.date(1979, 5, 27),
+        "e": datetime.time(7, 32, 0, 500000),
+    }
+    res = msgspec.toml.encode(msg)
+    assert res == (
+        b"a = 1979-05-27 07:32:00.123456+00:00\n"
+        b"b = 1979-05-27 07:32:00-07:00\n"
+        b"c = 1979-05-27 07:32:00\n"
+        b"d = 1979-05-27\n"
+        b"e = 07:32:00.500000\n"
+    )
+    assert msgspec.toml.decode(res) == msg
+
+
+def test_encode_tuple():
+    assert msgspec.toml.encode({"t": (1, "x")}) == b't = [\n    1,\n    "x",\n]\n'
+
+
+def test_encode_floats():
+    msg = {"a": 1e300, "b": 1e-7, "c": 1e-5, "d": 1e16, "e": 1.5, "f": 10.0}
+    res = msgspec.toml.encode(msg)
+    assert res == (b"a = 1e+300\nb = 1e-07\nc = 1e-05\nd = 1e+16\ne = 1.5\nf = 10.0\n")
+    assert msgspec.toml.decode(res) == msg
+
+
+def test_encode_nonfinite_floats():
+    res = msgspec.toml.encode(
+        {"a": float("inf"), "b": float("-inf"), "c": float("nan")}
+    )
+    assert res == b"a = inf\nb = -inf\nc = nan\n"
+
+
+def test_encode_struct():
+    class Point(msgspec.Struct):
+        x: int
+        y: int
+
+    class Shape(msgspec.Struct):
+        name: str
+        points: List[Point]
+        origin: Point
+
+    msg = Shape("tri", [Point(0, 0), Point(1, 1)], Point(2, 2))
+    res = msgspec.toml.encode(msg)
+    assert msgspec.toml.decode(res, type=Shape) == msg
+
+
+def test_encode_none_errors():
+    with pytest.raises(TypeError, match="TOML doesn't support encoding `None`"):
+        msgspec.toml.encode({"a": [1, None]})
+
+
+def test_encode_time_with_timezone_errors():
+    with pytest.raises(ValueError, match="TOML doesn't support times with a timezone"):
+        msgspec.toml.encode({"a": datetime.time(1, tzinfo=UTC)})
+
+
+@pytest.mark.parametrize("msg", [1, [{"a": 1}], "a = 1"])
+def test_encode_non_table_errors(msg):
+    with pytest.raises(TypeError, match="TOML documents must be a table"):
+        msgspec.toml.encode(msg)
+
+
+def test_encode_deeply_nested():
+    depth = 100000
+    msg = {}
+    for _ in range(depth):
+        msg = {"a": msg}
+    with pytest.raises(RecursionError):
+        msgspec.toml.encode(msg)
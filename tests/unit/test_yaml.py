@@ -51,7 +51,10 @@ def test_pyyaml_not_installed_error(monkeypatch):
         msgspec.yaml.encode(1)
 
     with pytest.raises(ImportError, match="PyYAML"):
-        msgspec.yaml.decode("1", type=int)
+        msgspec.yaml.decode("&a 1", type=int)
+
+    # Documents in the natively supported subset don't require PyYAML
+    assert msgspec.yaml.decode("a: [1, 2]") == {"a": [1, 2]}
 
 
 @pytest.mark.parametrize(
@@ -142,6 +145,77 @@ def test_decode_str_or_bytes_like():
         msgspec.yaml.decode(1)
 
 
+@pytest.mark.parametrize(
+    "msg",
+    [
+        "",
+        "# comment\n",
+        "---\na: 1\n",
+        "a: 1\nb:\n  c: x y\n  d: [1, 'two', {e: null}]\n",
+        "- a: 1\n  b: 2\n- - c\n  - d\n-\n  e: f\n",
+        "a:\n- 1\n- 2\nb: 3\n",
+        "a: 1\na: 2\n",
+        "'quoted key': 'it''s'\n\"k\": \"\\t\\u00e9\\x41\\N\"\n",
+        "a: [1,\n  2, 3,]\nb: {c: 1,\n  d: }\n",
+        "a: |\n  line 1\n\n  line 2\nb: |-\n  x\nc: |+\n  y\n\n",
+        "a: >\n  folded\n  text\n\n  here\n",
+        "a: 1 # comment\nb: http://example.com/#anchor\nc: x#y\n",
+        "ints: [0, -1, +2, 017, 0x1F, 0b101, 1_000, 08]\n",
+        "floats: [1.5, -1., .5, +.5, 1.5e+3, 1e5, .inf, -.Inf, 1__.__]\n",
+        "bools: [yes, No, ON, off, True, FALSE, y, n]\n",
+        "nulls: [~, null, Null, NULL, nul]\n",
+        "dates: [2001-12-14, 2001-12-14t21:59:43.10-05:00, 2001-12-14 21:59:43]\n",
+        "1: a\n1.5: b\nnull: c\n2001-12-14: d\n",
+        "unicode: 日本語\n",
+    ],
+)
+def test_decode_native_matches_pyyaml(msg):
+    sol = yaml.load(msg, Loader=yaml.SafeLoader)
+    assert msgspec._core._yaml_load(msg) is not NotImplemented
+    res = msgspec.yaml.decode(msg)
+    assert res == sol
+    assert msgspec.yaml.decode(msg.encode()) == res
+
+
+@pytest.mark.parametrize(
+    "msg",
+    [
+        "a: &x 1\nb: *x\n",
+        "a: !!str 1\n",
+        "<<: {a: 1}\n",
+        "? a\n: b\n",
+        "a: 1\n---\nb: 2\n",
+        "%YAML 1.1\n---\na: 1\n",
+        "a: multi\n  line\n",
+        "a: 'multi\n  line'\n",
+        "a: 1\r\nb: 2\r\n",
+        "a:\tb\n",
+        "a: 1:30\n",
+        "a: 2001-1-1 1:00:00\n",
+        "a: |2\n   x\n",
+        'a: "\\ud800"\n',
+        "a: [1, 2\n",
+    ],
+)
+def test_decode_fallback_to_pyyaml(msg):
+    assert msgspec._core._yaml_load(msg) is NotImplemented
+    Loader = getattr(yaml, "CSafeLoader", yaml.SafeLoader)
+    try:
+        sol = yaml.load(msg, Loader=Loader)
+    except yaml.YAMLError:
+        with pytest.raises(msgspec.DecodeError):
+            msgspec.yaml.decode(msg)
+    else:
+        assert msgspec.yaml.decode(msg) == sol
+
+
+def test_decode_native_deeply_nested():
+    msg = "[" * 10000 + "]" * 10000
+    with pytest.raises(RecursionError):
+        yaml.load(msg, Loader=yaml.SafeLoader)
+    assert msgspec._core._yaml_load(msg) is NotImplemented
+
+
 @pytest.mark.parametrize("msg", [b"{{", b"!!binary 123"])
 def test_decode_parse_error(msg):
     with pytest.raises(msgspec.DecodeError):